@@ -0,0 +1,36 @@
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> g_allocs{ 0 };
+static thread_local uint64_t t_allocs = 0;
+
+uint64_t AllocationCount()       { return g_allocs.load(std::memory_order_relaxed); }
+uint64_t ThreadAllocationCount() { return t_allocs; }
+
+static void* CountedAlloc(std::size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    ++t_allocs;
+    return std::malloc(size ? size : 1);
+}
+
+// ── Replaced global allocation functions ─────────────────────────────
+// The array and sized forms forward to these by default.
+
+void* operator new(std::size_t size)
+{
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept                        { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept           { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
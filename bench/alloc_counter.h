@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+// ── Heap allocation counter ──────────────────────────────────────────
+// alloc_counter.cpp replaces the global operator new / delete with thin
+// malloc / free wrappers that count every allocation, process-wide and
+// per thread.  Only the benchmarks link it: bench_entities samples the
+// counter around its steady-state ticks and fails if any allocated.
+
+// Allocations made by all threads since start.
+uint64_t AllocationCount();
+
+// Allocations made by the calling thread since it started.
+uint64_t ThreadAllocationCount();
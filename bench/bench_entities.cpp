@@ -0,0 +1,351 @@
+// ── Entity reader benchmark ──────────────────────────────────────────
+// Builds a synthetic JVM heap (an ArrayList of Entity objects, each with
+// a Box) in a SnapshotMemorySource and runs the real EntityReader over
+// it, one tick per "frame", for growing entity counts.  A quarter of
+// the entities move every tick, so Box reads and the id / delta work
+// stay representative.
+//
+// Per configuration it prints the mean and p99 tick time with its
+// stage split, the reader's reused storage (ArenaBytes()) and the heap
+// allocations, process-wide, over the ticks after the corruption below
+// (0 expected: the reader is warmed up by then).  Every tick's table
+// is checked against the heap, from the first one after Start() on.
+// The klass check is configured up front (1 thread) or pinned after the
+// first tick (4 threads).  Halfway through, one entity's klass word
+// turns to garbage, which must be rejected, and another's Box ref is
+// pointed at an Entity object, which must not be read as its Box.
+//
+// A snapshot read is a memcpy, far cheaper than ReadProcessMemory; the
+// optional latency argument spins that many microseconds per inner read
+// to model a live target, which is where the parallel fetch pays off.
+//
+// Usage: WD42_bench_entities [ticks] [read latency us]   (default 200 0)
+
+#include "alloc_counter.h"
+#include "entity.h"
+#include "memory_source.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Deterministic xorshift so runs are comparable.
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+static uint64_t NextRand()
+{
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return g_rng;
+}
+
+// ── Inner source with a per-read cost ────────────────────────────────
+class SlowSource final : public MemorySource {
+public:
+    SlowSource(MemorySource& inner, double latencyUs)
+        : inner(inner), latency(std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double, std::micro>(latencyUs))) {}
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override
+    {
+        if (latency.count() > 0) {
+            auto until = Clock::now() + latency;
+            while (Clock::now() < until) {}
+        }
+        return inner.Read(addr, dst, size);
+    }
+    std::vector<MemoryRegion> Regions() override { return inner.Regions(); }
+    std::vector<ModuleInfo>   Modules() override { return inner.Modules(); }
+
+private:
+    MemorySource&   inner;
+    Clock::duration latency;
+};
+
+// ── Synthetic heap ───────────────────────────────────────────────────
+// Layout matches the EntityOffsets / OopConfig defaults: compressed
+// oops (shift 3, base 0), an unlocked mark word and a 4-byte klass in
+// every header, ArrayList size at +0x10 / elementData at +0x14, Entity
+// position at +0x98..0xA8 and Box ref at +0xB0, Box doubles at +0x10.
+// Entities come in a few klasses, like a world's mix of mob types.
+// Entity and Box objects are interleaved with filler objects, and the
+// list order is shuffled, so fetches hit the heap the way a real
+// client's scattered allocations do.
+struct SyntheticHeap {
+    static constexpr uintptr_t kBase        = 0x10000000;
+    static constexpr uintptr_t kRoot        = kBase;
+    static constexpr uintptr_t kList        = kBase + 0x100;
+    static constexpr uintptr_t kArray       = kBase + 0x1000;
+    static constexpr size_t    kEntitySize  = 0xC0;
+    static constexpr size_t    kBoxSize     = 0x40;
+    static constexpr size_t    kFillerMax   = 0x200;
+    static constexpr uint64_t  kUnlocked    = 0x1;
+    static constexpr uint32_t  kListKlass   = 0x00C01000;
+    static constexpr uint32_t  kArrayKlass  = 0x00C02000;
+    static constexpr uint32_t  kBoxKlass    = 0x00C03000;
+    static constexpr uint32_t  kEntityKlass = 0x00C10000;   // + 0x100 per type
+    static constexpr int       kEntityTypes = 12;
+
+    SnapshotMemorySource       src;
+    std::vector<uintptr_t>     entities;    // by list slot
+    std::vector<uintptr_t>     boxes;
+    std::vector<uint32_t>      klasses;
+    std::vector<uint8_t>       garbage;     // klass word isn't an Entity's
+    std::vector<uint8_t>       strayBox;    // Box ref points at a non-Box
+
+    explicit SyntheticHeap(int count)
+    {
+        size_t objects = kArray + 0x10 + count * 4 + 0x1000;
+        objects = (objects + 0xFFF) & ~size_t(0xFFF);
+        size_t size = objects - kBase +
+                      count * (kEntitySize + kBoxSize + kFillerMax) + 0x1000;
+        std::vector<uint8_t> bytes(size, 0);
+        auto put = [&](uintptr_t addr, auto v) {
+            std::memcpy(&bytes[addr - kBase], &v, sizeof(v));
+        };
+
+        auto header = [&](uintptr_t obj, uint32_t klass) {
+            put(obj, kUnlocked);
+            put(obj + 0x08, klass);
+        };
+
+        put(kRoot, static_cast<uint64_t>(kList));
+        header(kList, kListKlass);
+        put(kList + 0x10, static_cast<int32_t>(count));
+        put(kList + 0x14, static_cast<uint32_t>(kArray >> 3));
+        header(kArray, kArrayKlass);
+        put(kArray + 0x0C, static_cast<int32_t>(count));
+
+        uintptr_t at = objects;
+        for (int i = 0; i < count; ++i) {
+            entities.push_back(at);
+            at += kEntitySize;
+            boxes.push_back(at);
+            at += kBoxSize;
+            at += (NextRand() % kFillerMax) & ~uintptr_t(7);
+        }
+
+        // Shuffle which object sits in which list slot
+        for (int i = count - 1; i > 0; --i) {
+            int j = static_cast<int>(NextRand() % (i + 1));
+            std::swap(entities[i], entities[j]);
+            std::swap(boxes[i], boxes[j]);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            klasses.push_back(kEntityKlass + 0x100 * static_cast<uint32_t>(NextRand() % kEntityTypes));
+            put(kArray + 0x10 + i * 4, static_cast<uint32_t>(entities[i] >> 3));
+            header(entities[i], klasses[i]);
+            put(entities[i] + 0xB0, static_cast<uint32_t>(boxes[i] >> 3));
+            header(boxes[i], kBoxKlass);
+        }
+
+        MemoryRegion region;
+        region.base = kBase;
+        region.size = bytes.size();
+        src.AddRegion(region, bytes.data());
+        garbage.assign(count, 0);
+        strayBox.assign(count, 0);
+
+        for (int i = 0; i < count; ++i)
+            Place(i, (NextRand() % 2000) * 0.5 - 500.0, 64.0,
+                  (NextRand() % 2000) * 0.5 - 500.0);
+    }
+
+    size_t Bytes() { return src.Regions().front().size; }
+
+    // Put entity `slot` at (x, y, z), its Box 0.6 x 1.8 around it.
+    void Place(int slot, double x, double y, double z)
+    {
+        double* pos = reinterpret_cast<double*>(src.Data(entities[slot] + 0x98, 24));
+        pos[0] = x; pos[1] = y; pos[2] = z;
+        double* box = reinterpret_cast<double*>(src.Data(boxes[slot] + 0x10, 48));
+        box[0] = x - 0.3; box[1] = y;       box[2] = z - 0.3;
+        box[3] = x + 0.3; box[4] = y + 1.8; box[5] = z + 0.3;
+    }
+
+    const double* Position(int slot)
+    {
+        return reinterpret_cast<const double*>(src.Data(entities[slot] + 0x98, 24));
+    }
+
+    // The klasses a reader should expect.
+    EntityKlasses Expected() const
+    {
+        EntityKlasses k;
+        for (int t = 0; t < kEntityTypes; ++t)
+            k.entity.push_back(kEntityKlass + 0x100 * t);
+        k.box.push_back(kBoxKlass);
+        return k;
+    }
+
+    // Overwrite entity `slot`'s klass word (true: with garbage).
+    void SetGarbage(int slot, bool on)
+    {
+        uint32_t klass = on ? 0xDEAD0000u : klasses[slot];
+        std::memcpy(src.Data(entities[slot] + 0x08, 4), &klass, 4);
+        garbage[slot] = on;
+    }
+
+    // Point entity `slot`'s Box ref at another entity (true) or back
+    // at its own Box.
+    void SetStrayBox(int slot, bool on)
+    {
+        uintptr_t to = on ? entities[(slot + 1) % entities.size()] : boxes[slot];
+        uint32_t  ref = static_cast<uint32_t>(to >> 3);
+        std::memcpy(src.Data(entities[slot] + 0xB0, 4), &ref, 4);
+        strayBox[slot] = on;
+    }
+
+    void MoveSome(int count)
+    {
+        for (int n = 0; n < count; ++n) {
+            int slot = static_cast<int>(NextRand() % entities.size());
+            const double* p = Position(slot);
+            Place(slot, p[0] + 0.125, p[1], p[2] - 0.125);
+        }
+    }
+};
+
+// Every row must match the heap at its object's position, with the Box
+// around it; a garbage-klass row must be rejected, a row with a stray
+// Box ref must have no Box.  Rows are in list order (no null refs here).
+static int CountBad(const EntityTable& tab, SyntheticHeap& heap)
+{
+    if (tab.Size() != heap.entities.size()) return -1;
+    int bad = 0;
+    for (size_t k = 0; k < tab.Size(); ++k) {
+        const double* p = heap.Position(static_cast<int>(k));
+        if (heap.garbage[k]) {
+            if (tab.Valid(k) || !(tab.flags[k] & entity_flag::Rejected)) ++bad;
+            continue;
+        }
+        if (heap.strayBox[k]) {
+            if (!tab.Valid(k) || (tab.flags[k] & entity_flag::HasBox)) ++bad;
+            continue;
+        }
+        if (!tab.Valid(k) || !(tab.flags[k] & entity_flag::HasBox) ||
+            tab.posX[k] != p[0] || tab.posY[k] != p[1] || tab.posZ[k] != p[2] ||
+            tab.bbMinX[k] != p[0] - 0.3 || tab.bbMaxY[k] != p[1] + 1.8)
+            ++bad;
+    }
+    return bad;
+}
+
+struct Result {
+    double   meanUs = 0, p99Us = 0;
+    double   sliceUs = 0, entitiesUs = 0, boxesUs = 0;
+    size_t   arena = 0;
+    uint64_t allocs = 0;
+    int      bad = 0;
+    int      threads = 0;       // after the pool's clamp to the core count
+};
+
+static Result Run(SyntheticHeap& heap, MemorySource& src, int threads, int ticks)
+{
+    const bool pin = threads > 1;
+
+    EntityReader reader;
+    reader.SetChain(SyntheticHeap::kRoot, { 0 });
+    if (!pin) reader.SetKlasses(heap.Expected());
+    reader.schedule     = ScheduleMode::FrameAligned;
+    reader.fetchThreads = threads;
+    reader.printEntities = false;
+    reader.SetReadEnabled(true);
+    reader.Start(src);
+
+    // One tick per NotifyFrame(); the heap is only touched between a
+    // published snapshot and the next notify, never during a read.
+    auto tick = [&]() -> const EntitySnapshot& {
+        reader.NotifyFrame();
+        while (!reader.HasNewSnapshot())
+            std::this_thread::yield();
+        return reader.AcquireSnapshot();
+    };
+
+    Result r;
+    auto check = [&](const EntitySnapshot& s) {
+        int bad = CountBad(s.entities, heap);
+        r.bad += bad < 0 ? static_cast<int>(heap.entities.size()) : bad;
+    };
+
+    // Warm up: storage grows to size.  Rows must be right from the
+    // first tick on; the pinned klasses are the first tick's.
+    for (int i = 0; i < 5; ++i) {
+        check(tick());
+        if (pin && i == 0) reader.PinKlasses();
+    }
+
+    std::vector<double> total;
+    total.reserve(ticks);
+    uint64_t allocsAt = 0;
+    const int moving = static_cast<int>(heap.entities.size() / 4);
+    for (int i = 0; i < ticks; ++i) {
+        heap.MoveSome(moving);
+        if (i == ticks / 2) {
+            heap.SetGarbage(0, true);
+            heap.SetStrayBox(1, true);
+        }
+        if (i == ticks / 2 + 1)
+            allocsAt = AllocationCount();
+        const EntitySnapshot& s = tick();
+        total.push_back(s.timings.totalUs);
+        r.sliceUs    += s.timings.sliceUs;
+        r.entitiesUs += s.timings.entitiesUs;
+        r.boxesUs    += s.timings.boxesUs;
+        check(s);
+    }
+    if (ticks / 2 + 1 < ticks)
+        r.allocs = AllocationCount() - allocsAt;
+    heap.SetGarbage(0, false);
+    heap.SetStrayBox(1, false);
+    r.threads = reader.FetchThreads();
+    r.arena  = reader.ArenaBytes();
+    reader.Stop();
+
+    std::sort(total.begin(), total.end());
+    for (double us : total) r.meanUs += us;
+    r.meanUs     /= ticks;
+    r.sliceUs    /= ticks;
+    r.entitiesUs /= ticks;
+    r.boxesUs    /= ticks;
+    r.p99Us = total[std::min(total.size() - 1, total.size() * 99 / 100)];
+    return r;
+}
+
+int main(int argc, char** argv)
+{
+    int    ticks     = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 200;
+    double latencyUs = (argc > 2) ? std::atof(argv[2]) : 0.0;
+
+    std::printf("Entity read ticks (%d per row, %.1f us per inner read, 25%% moving, %u cores)\n",
+                ticks, latencyUs, std::thread::hardware_concurrency());
+    std::printf("%8s %8s %8s %10s %10s %10s %10s %10s %10s %8s %6s\n",
+                "entities", "heap KB", "threads", "tick us", "p99 us", "slice us",
+                "ent us", "box us", "arena KB", "allocs", "bad");
+
+    const int counts[]  = { 256, 2048, 10000 };
+    const int threads[] = { 1, 4 };
+    bool ok = true;
+    for (int count : counts) {
+        SyntheticHeap heap(count);
+        SlowSource slow(heap.src, latencyUs);
+        for (int t : threads) {
+            Result r = Run(heap, slow, t, ticks);
+            std::printf("%8d %8zu %8d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %8llu %6d\n",
+                        count, heap.Bytes() / 1024, r.threads, r.meanUs, r.p99Us, r.sliceUs,
+                        r.entitiesUs, r.boxesUs, r.arena / 1024.0,
+                        static_cast<unsigned long long>(r.allocs), r.bad);
+            ok = ok && r.bad == 0 && r.allocs == 0;
+        }
+    }
+
+    std::printf("%s\n", ok ? "OK" : "FAILED (wrong rows or steady-state allocations)");
+    return ok ? 0 : 1;
+}
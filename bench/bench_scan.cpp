@@ -0,0 +1,227 @@
+// ── Scan kernel benchmark ────────────────────────────────────────────
+// Runs every available match kernel over a synthetic buffer, checks
+// that all of them report exactly the scalar kernel's offsets, and
+// prints throughput in GB/s.
+//
+// The second section compares one multi-pattern pass against running
+// the single-pattern kernel once per pattern, for growing set sizes.
+//
+// With a snapshot file (see snapshot_file.h) the last section also runs
+// the whole-process scanners against that frozen address space, so runs
+// on different days / machines scan exactly the same bytes.
+//
+// Usage: WD42_bench_scan [buffer MB] [snapshot.wsnap]   (default 256)
+
+#include "scan_kernels.h"
+#include "multi_pattern.h"
+#include "scanner.h"
+#include "snapshot_file.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Deterministic xorshift so runs are comparable.
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+static uint64_t NextRand()
+{
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return g_rng;
+}
+
+// Heap-like data: lots of zeros and small values, some random noise.
+static void FillSynthetic(std::vector<uint8_t>& buf)
+{
+    for (auto& b : buf) {
+        uint64_t r = NextRand();
+        switch (r & 7) {
+        case 0: case 1: case 2: b = 0x00; break;
+        case 3:                 b = static_cast<uint8_t>((r >> 8) & 0x0F); break;
+        case 4:                 b = 0x48; break;
+        default:                b = static_cast<uint8_t>(r >> 8); break;
+        }
+    }
+}
+
+static void Plant(std::vector<uint8_t>& buf, const std::vector<uint8_t>& bytes,
+                  size_t every)
+{
+    for (size_t at = every / 2; at + bytes.size() <= buf.size(); at += every)
+        std::memcpy(buf.data() + at, bytes.data(), bytes.size());
+}
+
+struct BenchPattern {
+    const char*   name;
+    ParsedPattern pattern;
+};
+
+int main(int argc, char** argv)
+{
+    size_t mb = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 256;
+    if (mb == 0) mb = 256;
+
+    std::vector<uint8_t> buf(mb << 20);
+    FillSynthetic(buf);
+
+    std::vector<BenchPattern> patterns;
+    patterns.push_back({ "code sig (wildcards)",
+        ParsePattern("48 8B 05 ?? ?? ?? ?? 48 85 C0") });
+    patterns.push_back({ "class name (36 B)",
+        PatternFromString("net/minecraft/client/MinecraftClient") });
+    patterns.push_back({ "short (2 B)", ParsePattern("0F 05") });
+
+    Plant(buf, { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0 },
+          1 << 20);
+    {
+        const char* s = "net/minecraft/client/MinecraftClient";
+        Plant(buf, std::vector<uint8_t>(s, s + std::strlen(s)), 3 << 20);
+    }
+
+    ScanKernel best = BestScanKernel();
+    std::vector<ScanKernel> kernels = { ScanKernel::Scalar, ScanKernel::SSE2 };
+    if (best == ScanKernel::AVX2) kernels.push_back(ScanKernel::AVX2);
+
+    std::printf("[bench] buffer %zu MB, best kernel: %s\n\n",
+                mb, ScanKernelName(best));
+
+    int failures = 0;
+    for (auto& bp : patterns) {
+        CompiledPattern cp = CompilePattern(bp.pattern.View());
+        std::vector<size_t> reference;
+
+        std::printf("%-22s anchor=+%zu (0x%02X)\n", bp.name,
+                    cp.anchor, cp.bytes[cp.anchor]);
+
+        for (ScanKernel k : kernels) {
+            std::vector<size_t> hits;
+            auto t0 = std::chrono::steady_clock::now();
+            FindMatchesWith(k, buf.data(), buf.size(), cp, hits);
+            auto t1 = std::chrono::steady_clock::now();
+
+            double sec = std::chrono::duration<double>(t1 - t0).count();
+            double gbs = (static_cast<double>(buf.size()) / 1e9) / sec;
+
+            bool same = true;
+            if (k == ScanKernel::Scalar) reference = hits;
+            else same = (hits == reference);
+            if (!same) ++failures;
+
+            std::printf("  %-7s %8.2f GB/s  %8zu hits  %s\n",
+                        ScanKernelName(k), gbs, hits.size(),
+                        same ? "" : "MISMATCH vs scalar");
+        }
+        std::printf("\n");
+    }
+
+    // ── Compile-time pattern: same layout as the parsed string ───────
+    {
+        auto fixedPat = "48 8B 05 ?? ?? ?? ?? 48 85 C0"_pat;
+        ParsedPattern fixed  = fixedPat.ToParsed();
+        ParsedPattern parsed = ParsePattern("48 8B 05 ?? ?? ?? ?? 48 85 C0");
+
+        bool same = (fixed.bytes == parsed.bytes && fixed.mask == parsed.mask);
+        if (!same) ++failures;
+        std::printf("Pattern<\"48 8B 05 ...\">  %s\n\n",
+                    same ? "same layout as ParsePattern()" : "MISMATCH");
+    }
+
+    // ── Multi-pattern: one pass vs. N single-pattern passes ──────────
+    std::printf("multi-pattern         single-pass   N x %s\n",
+                ScanKernelName(best));
+
+    // Class-name signatures first (the string-scan workload), then
+    // random wildcard patterns to grow the set.
+    std::vector<BenchPattern> pool;
+    for (const char* sig : {
+             "net/minecraft/client/MinecraftClient",
+             "net/minecraft/client/Minecraft",
+             "net/minecraft/entity/Entity",
+             "net/minecraft/entity/player/PlayerEntity",
+             "net/minecraft/entity/player/EntityPlayer",
+             "net/minecraft/client/world/ClientWorld",
+             "net/minecraft/world/entity/LivingEntity",
+             "net/minecraft/world/level/Level" })
+        pool.push_back({ "class name", PatternFromString(sig) });
+
+    while (pool.size() < 32) {
+        BenchPattern extra{ "random", {} };
+        size_t len = 12 + NextRand() % 24;
+        for (size_t i = 0; i < len; ++i) {
+            extra.pattern.bytes.push_back(static_cast<uint8_t>(NextRand()));
+            extra.pattern.mask.push_back((NextRand() & 7) ? 0xFF : 0x00);
+        }
+        pool.push_back(extra);
+    }
+
+    for (size_t n : { size_t(1), size_t(8), size_t(32) }) {
+        MultiPatternMatcher matcher;
+        std::vector<CompiledPattern> singles;
+        for (size_t i = 0; i < n; ++i) {
+            matcher.AddPattern(pool[i].pattern.View());
+            singles.push_back(CompilePattern(pool[i].pattern.View()));
+        }
+        matcher.Build();
+
+        std::vector<PatternMatch> multiHits;
+        MultiPatternMatcher::Scratch scratch;
+        auto t0 = std::chrono::steady_clock::now();
+        matcher.Find(buf.data(), buf.size(), multiHits, scratch);
+        auto t1 = std::chrono::steady_clock::now();
+
+        size_t singleHits = 0;
+        for (auto& cp : singles) {
+            std::vector<size_t> hits;
+            FindMatches(buf.data(), buf.size(), cp, hits);
+            singleHits += hits.size();
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        bool same = (singleHits == multiHits.size());
+        if (!same) ++failures;
+
+        std::printf("  %2zu patterns  %8.1f ms    %8.1f ms  %8zu hits  %s\n", n,
+                    std::chrono::duration<double, std::milli>(t1 - t0).count(),
+                    std::chrono::duration<double, std::milli>(t2 - t1).count(),
+                    multiHits.size(), same ? "" : "MISMATCH");
+    }
+
+    // ── Whole-process scans over a captured snapshot ─────────────────
+    if (argc > 2) {
+        auto t0 = std::chrono::steady_clock::now();
+        MappedSnapshotSource snap;
+        if (!snap.Open(argv[2])) {
+            std::printf("\n[bench] cannot open snapshot %s\n", argv[2]);
+            return 1;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        std::printf("\nsnapshot %s: %zu regions, %llu MB, opened in %.2f ms\n",
+                    argv[2], snap.Regions().size(),
+                    static_cast<unsigned long long>(snap.DataBytes() >> 20),
+                    std::chrono::duration<double, std::milli>(t1 - t0).count());
+
+        for (auto& bp : patterns) {
+            auto s0 = std::chrono::steady_clock::now();
+            auto hits = PatternScan(snap, bp.pattern);
+            auto s1 = std::chrono::steady_clock::now();
+            std::printf("  %-22s %8.1f ms  %8zu hits\n", bp.name,
+                        std::chrono::duration<double, std::milli>(s1 - s0).count(),
+                        hits.size());
+        }
+
+        std::vector<ParsedPattern> classNames;
+        for (size_t i = 0; i < 8; ++i) classNames.push_back(pool[i].pattern);
+        auto s0 = std::chrono::steady_clock::now();
+        auto multi = PatternScanMulti(snap, classNames);
+        auto s1 = std::chrono::steady_clock::now();
+        std::printf("  %-22s %8.1f ms  %8zu hits\n", "8 class names (multi)",
+                    std::chrono::duration<double, std::milli>(s1 - s0).count(),
+                    multi.size());
+    }
+
+    return failures ? 1 : 0;
+}
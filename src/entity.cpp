@@ -1,10 +1,11 @@
 #include "entity.h"
-#include "mc_process.h"   // ReadMemory<T>, ReadBytes
-#include "scanner.h"   // PatternScan, ParsePattern
+#include "scanner.h"   // PatternScanMulti, PatternFromString
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <cmath>
 
 // ── Known Minecraft class-name strings (UTF-8) to scan for ───────────
 // These live in the JVM metaspace / constant pool.  Finding them proves
@@ -29,11 +30,16 @@ EntityReader::~EntityReader()
     Stop();
 }
 
-void EntityReader::Start(HANDLE process)
+void EntityReader::Start(MemorySource& source)
 {
     if (running.load()) return;
 
-    hProcess = process;
+    mem = &source;
+    cache.Attach(mem);
+    cache.ResetStats();
+    chain.valid = false;
+    pool.Start(source, fetchThreads);
+    scheduler.Reset();      // here, so a frame notified after Start() is never dropped
     running.store(true);
 
     worker = std::thread(&EntityReader::WorkerLoop, this);
@@ -43,36 +49,94 @@ void EntityReader::Start(HANDLE process)
 void EntityReader::Stop()
 {
     running.store(false);
+    scheduler.Wake();
     if (worker.joinable())
         worker.join();
+    pool.Stop();
     std::cout << "[entity] Background reader stopped\n";
 }
 
 // =====================================================================
-//  Thread-safe accessors
+//  Accessors / publication
 // =====================================================================
 
-std::vector<EntityData> EntityReader::GetEntities() const
+const EntitySnapshot& EntityReader::AcquireSnapshot()
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    return entities;
+    published.Acquire();
+    return published.Front();
 }
 
-std::vector<StringFind> EntityReader::GetStringFinds() const
+std::shared_ptr<const std::vector<StringFind>> EntityReader::GetStringFinds() const
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    return stringFinds;
+    return stringFinds.load();
 }
 
-std::string EntityReader::GetStatus() const
+CachedMemorySource::Stats EntityReader::GetCacheStats() const
 {
-    std::lock_guard<std::mutex> lk(mtx);
-    return status;
+    auto s = cache.GetStats();
+    auto p = pool.GetCacheStats();
+    s.hits     += p.hits;
+    s.misses   += p.misses;
+    s.bypassed += p.bypassed;
+    return s;
+}
+
+void EntityReader::Publish()
+{
+    current.delta.base = current.sequence++;
+
+    // Copy-assignment reuses a slot's storage only while it is big
+    // enough; give the delta lists the capacity `current` settled on
+    EntitySnapshot& back = published.Back();
+    back.delta.entered.reserve(current.delta.entered.capacity());
+    back.delta.left.reserve(current.delta.left.capacity());
+    back.delta.moved.reserve(current.delta.moved.capacity());
+    back = current;
+    published.Publish();
+
+    // The delta is relative to this snapshot from now on
+    current.delta.entered.clear();
+    current.delta.left.clear();
+    current.delta.moved.clear();
+    current.delta.rekeyed = 0;
+}
+
+void EntityReader::PublishStatus(const char* text)
+{
+    current.status = text;
+    Publish();
 }
 
 void EntityReader::RequestStringScan()
 {
     stringScanRequested.store(true);
+    scheduler.Wake();
+}
+
+void EntityReader::SetReadEnabled(bool on)
+{
+    entityReadEnabled.store(on);
+    scheduler.Wake();
+}
+
+void EntityReader::SetChain(uintptr_t base, std::vector<int> chainOffsets)
+{
+    auto config = std::make_shared<EntityChain>();
+    config->base    = base;
+    config->offsets = std::move(chainOffsets);
+
+    std::lock_guard<std::mutex> lk(chainMtx);
+    chainConfig = std::move(config);
+    chainVersion.fetch_add(1, std::memory_order_release);
+}
+
+void EntityReader::SetKlasses(EntityKlasses klasses)
+{
+    auto config = std::make_shared<const EntityKlasses>(std::move(klasses));
+
+    std::lock_guard<std::mutex> lk(klassMtx);
+    klassConfig = std::move(config);
+    klassVersion.fetch_add(1, std::memory_order_release);
 }
 
 // =====================================================================
@@ -84,66 +148,452 @@ void EntityReader::WorkerLoop()
     while (running.load()) {
         // Handle one-shot string scan request
         if (stringScanRequested.exchange(false)) {
-            {
-                std::lock_guard<std::mutex> lk(mtx);
-                status = "Scanning for JVM class strings...";
-            }
+            PublishStatus("Scanning for JVM class strings...");
             DoStringScan();
+            continue;
         }
 
+        // Nothing to do: sleep until reads are enabled, a scan is
+        // requested or Stop() is called
+        if (!entityReadEnabled.load()) {
+            scheduler.WaitIdle([this] {
+                return !running.load() || stringScanRequested.load() ||
+                       entityReadEnabled.load();
+            });
+            continue;
+        }
+
+        // Woken early: state changed, re-check it before reading
+        if (!scheduler.WaitNextTick(schedule, readIntervalMs, cpuBudget))
+            continue;
+
         // Continuous entity reads
-        if (entityReadEnabled.load() && offsets.chainBase != 0) {
+        scheduler.TickStarted();
+        if (SyncChain())
             DoEntityRead();
+        scheduler.TickFinished();
+    }
+
+    PublishStatus("stopped");
+}
+
+// =====================================================================
+//  Entity tables
+// =====================================================================
+
+void EntityTable::Resize(size_t n)
+{
+    id.resize(n);
+    flags.resize(n);
+    for (auto* col : { &posX, &posY, &posZ,
+                       &bbMinX, &bbMinY, &bbMinZ, &bbMaxX, &bbMaxY, &bbMaxZ })
+        col->resize(n);
+}
+
+void ToCameraRelative(const EntityTable& in, double camX, double camY, double camZ,
+                      EntityTableF& out)
+{
+    const size_t n = in.Size();
+    out.id.assign(in.id.begin(), in.id.end());
+    out.flags.assign(in.flags.begin(), in.flags.end());
+
+    // One pass per column; each is a plain subtract-and-narrow loop
+    // the compiler vectorizes
+    auto rel = [n](const std::vector<double>& src, double origin, std::vector<float>& dst) {
+        dst.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            dst[i] = static_cast<float>(src[i] - origin);
+    };
+    rel(in.posX,   camX, out.x);
+    rel(in.posY,   camY, out.y);
+    rel(in.posZ,   camZ, out.z);
+    rel(in.bbMinX, camX, out.minX);
+    rel(in.bbMinY, camY, out.minY);
+    rel(in.bbMinZ, camZ, out.minZ);
+    rel(in.bbMaxX, camX, out.maxX);
+    rel(in.bbMaxY, camY, out.maxY);
+    rel(in.bbMaxZ, camZ, out.maxZ);
+}
+
+// =====================================================================
+//  Object spans
+// =====================================================================
+
+// Smallest [begin, end) covering every (offset, size) field.
+static ObjectSpan CoverFields(std::initializer_list<std::pair<int, int>> fields)
+{
+    int lo = fields.begin()->first;
+    int hi = lo;
+    for (auto [off, size] : fields) {
+        lo = std::min(lo, off);
+        hi = std::max(hi, off + size);
+    }
+    return { lo, hi - lo };
+}
+
+ObjectSpan EntityOffsets::EntitySpan(const OopConfig& oops) const
+{
+    return CoverFields({ { 0, 8 }, { oops.klassOffset, oops.KlassSize() },
+                         { posXOffset, 8 }, { posYOffset, 8 }, { posZOffset, 8 },
+                         { bbRefOffset, oops.RefSize() } });
+}
+
+ObjectSpan EntityOffsets::BoxSpan(const OopConfig& oops) const
+{
+    return CoverFields({ { 0, 8 }, { oops.klassOffset, oops.KlassSize() },
+                         { bbMinXOffset, 8 }, { bbMinYOffset, 8 }, { bbMinZOffset, 8 },
+                         { bbMaxXOffset, 8 }, { bbMaxYOffset, 8 }, { bbMaxZOffset, 8 } });
+}
+
+// =====================================================================
+//  Object headers
+// =====================================================================
+
+// The low two bits of a HotSpot mark word are the lock state.  0b11
+// ("marked") is what a copying GC leaves in the old copy of an object
+// it has moved; the rest of the word then points at the new copy.
+static constexpr uint64_t kMarkLockMask  = 0x3;
+static constexpr uint64_t kMarkForwarded = 0x3;
+
+static bool Forwarded(uint64_t mark)
+{
+    return (mark & kMarkLockMask) == kMarkForwarded;
+}
+
+// At least one in this many fetched entities forwarded: the GC is
+// relocating the heap and the list we followed is stale.
+static constexpr int kRelocatedShare = 4;
+
+bool EntityReader::KlassSet::Accepts(uint64_t klass) const
+{
+    return klasses.empty() || std::binary_search(klasses.begin(), klasses.end(), klass);
+}
+
+void EntityReader::KlassSet::Assign(std::vector<uint64_t> words)
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    klasses = std::move(words);
+}
+
+void EntityReader::SyncKlasses()
+{
+    uint64_t version = klassVersion.load(std::memory_order_acquire);
+    if (version != klassAdopted) {
+        std::shared_ptr<const EntityKlasses> config;
+        {
+            std::lock_guard<std::mutex> lk(klassMtx);
+            config       = klassConfig;
+            klassAdopted = klassVersion.load(std::memory_order_relaxed);
         }
+        entityKlasses.Assign(config ? config->entity : std::vector<uint64_t>{});
+        boxKlasses.Assign(config ? config->box : std::vector<uint64_t>{});
+    }
 
-        Sleep(static_cast<DWORD>(readIntervalMs));
+    // Pin what the last published rows were read as
+    if (pinKlassesRequested.exchange(false)) {
+        std::vector<uint64_t> entity, box;
+        const auto& tab = tracked.table;
+        for (size_t k = 0; k < tab.Size(); ++k) {
+            if (tab.Valid(k))
+                entity.push_back(tracked.klasses[k]);
+            if (tab.flags[k] & entity_flag::HasBox)
+                box.push_back(tracked.boxKlasses[k]);
+        }
+        entityKlasses.Assign(std::move(entity));
+        boxKlasses.Assign(std::move(box));
     }
 
-    std::lock_guard<std::mutex> lk(mtx);
-    status = "stopped";
+    current.entityKlasses = static_cast<int>(entityKlasses.klasses.size());
+    current.boxKlasses    = static_cast<int>(boxKlasses.klasses.size());
 }
 
 // =====================================================================
 //  JVM Oop dereference
 // =====================================================================
 
-uintptr_t EntityReader::ReadOop(uintptr_t addr) const
+uintptr_t EntityReader::DecodeOop(uint64_t raw) const
 {
-    if (oops.compressed) {
-        // Compressed oop: 4-byte ref, decode = (ref << shift) + heapBase
-        auto ref = ReadMemory<uint32_t>(hProcess, addr);
-        if (!ref || *ref == 0) return 0;
-        return (static_cast<uintptr_t>(*ref) << oops.shift) + oops.heapBase;
-    } else {
-        // Raw 8-byte pointer
-        auto ptr = ReadMemory<uint64_t>(hProcess, addr);
-        if (!ptr || *ptr == 0) return 0;
-        return static_cast<uintptr_t>(*ptr);
-    }
+    if (raw == 0) return 0;
+    if (oops.compressed)
+        return (static_cast<uintptr_t>(static_cast<uint32_t>(raw)) << oops.shift)
+             + oops.heapBase;
+    return static_cast<uintptr_t>(raw);
 }
 
 // =====================================================================
 //  Pointer chain follower
 // =====================================================================
 
-uintptr_t EntityReader::FollowChain() const
+// A cached chain is walked again after this many ticks even if its
+// terminal checks out, in case another object of the same klass took
+// the terminal's place.
+static constexpr int kChainRecheckTicks = 100;
+
+bool EntityReader::SyncChain()
 {
-    uintptr_t addr = offsets.chainBase;
+    uint64_t version = chainVersion.load(std::memory_order_acquire);
+    if (version != chain.version) {
+        std::lock_guard<std::mutex> lk(chainMtx);
+        chain.config  = chainConfig;
+        chain.version = chainVersion.load(std::memory_order_relaxed);
+        chain.valid   = false;
+    }
+    return chain.config && chain.config->base != 0;
+}
+
+template <typename Source>
+uintptr_t EntityReader::FollowChain(Source& src)
+{
+    const EntityChain& config = *chain.config;
+    chain.hops.clear();
+    chain.listAddr   = 0;
+    chain.arrayKlass = 0;
+
+    uintptr_t addr = config.base;
     if (addr == 0) return 0;
 
-    for (size_t i = 0; i < offsets.chainOffsets.size(); ++i) {
+    for (size_t i = 0; i < config.offsets.size(); ++i) {
         // Dereference the current pointer
-        auto ptr = ReadMemory<uint64_t>(hProcess, addr);
+        auto ptr = ReadValue<uint64_t>(src, addr);
+        ++current.timings.chainReads;
         if (!ptr || *ptr == 0) return 0;
         addr = static_cast<uintptr_t>(*ptr);
+        chain.hops.push_back(addr);
 
         // Apply the next offset
-        addr += offsets.chainOffsets[i];
+        addr += config.offsets[i];
     }
 
+    chain.listAddr = addr;
     return addr;
 }
 
+template <typename Source>
+const char* EntityReader::ReadListHeader(Source& src, uintptr_t& listAddr, int& count,
+                                         uintptr_t& arrayRef)
+{
+    const int refSize   = oops.RefSize();
+    const int klassSize = oops.KlassSize();
+
+    bool cached = chain.valid && chain.age < kChainRecheckTicks;
+
+    for (;;) {
+        if (!cached) {
+            chain.valid = false;
+            if (FollowChain(src) == 0) return "Chain resolved to NULL";
+        }
+
+        // One read from the terminal object's header through the
+        // list's size and elementData ref
+        uintptr_t object = chain.hops.empty() ? chain.config->base : chain.hops.back();
+        int at = static_cast<int>(static_cast<intptr_t>(chain.listAddr - object));
+        const ObjectSpan span = CoverFields({ { 0, 8 }, { oops.klassOffset, klassSize },
+                                              { at + offsets.listSizeOffset, 4 },
+                                              { at + offsets.listArrayOffset, refSize } });
+        auto& bytes = scratch.listBytes;
+        bytes.resize(span.size);
+        bool ok = src.Read(object + span.begin, bytes.data(), bytes.size()) == bytes.size();
+        ++current.timings.chainReads;
+
+        uint64_t mark = 0, klass = 0, ref = 0;
+        int32_t  size = 0;
+        if (ok) {
+            std::memcpy(&mark, bytes.data() - span.begin, 8);
+            std::memcpy(&klass, bytes.data() + (oops.klassOffset - span.begin), klassSize);
+            std::memcpy(&size, bytes.data() + (at + offsets.listSizeOffset - span.begin), 4);
+            std::memcpy(&ref, bytes.data() + (at + offsets.listArrayOffset - span.begin), refSize);
+        }
+        arrayRef = DecodeOop(ref);
+
+        // Terminal moved or gone since the walk: walk again
+        if (cached && (!ok || Forwarded(mark) || klass != chain.klass || arrayRef == 0)) {
+            cached = false;
+            continue;
+        }
+        if (!ok)             return "Failed to read entity count";
+        if (Forwarded(mark)) return "Entity list is being moved (GC)";
+        if (arrayRef == 0)   return "Entity array ref is NULL";
+
+        if (!chain.valid) {
+            chain.klass = klass;
+            chain.age   = 0;
+            chain.valid = true;
+        }
+        ++chain.age;
+
+        listAddr = chain.listAddr;
+        count    = size;
+        return nullptr;
+    }
+}
+
+// =====================================================================
+//  Entity identity
+// =====================================================================
+
+// An unmatched entity in the same list slot as an unmatched one from
+// last tick, and within this distance of it, is taken to be the same
+// object moved by the GC.
+static constexpr double kRekeyDistance = 1.0;
+
+void EntityReader::IdentifyEntities(EntityTable& tab)
+{
+    const auto& prev   = tracked.table;
+    const auto& addrs  = scratch.entityAddrs;
+    const auto& slots  = scratch.indices;
+    auto& prevRow  = scratch.prevRow;
+    auto& prevUsed = scratch.prevUsed;
+    auto& delta    = current.delta;
+
+    prevRow.assign(tab.Size(), -1);
+    prevUsed.assign(prev.Size(), 0);
+
+    // 1. Same object address as last tick.  Usually it's also in the
+    //    same list slot: both tables are in slot order, so one merge
+    //    walk matches those without any lookup.
+    size_t unmatched = 0;
+    for (size_t k = 0, p = 0; k < tab.Size(); ++k) {
+        while (p < prev.Size() && tracked.slots[p] < slots[k]) ++p;
+        if (p < prev.Size() && tracked.slots[p] == slots[k] &&
+            tracked.addrs[p] == addrs[k]) {
+            prevRow[k] = static_cast<int32_t>(p);
+            prevUsed[p] = 1;
+        } else {
+            ++unmatched;
+        }
+    }
+
+    //    The rest (shifted by list inserts / removals) are looked up
+    //    among last tick's unmatched rows, sorted by address.
+    auto& byAddr = scratch.byAddr;
+    byAddr.clear();
+    if (unmatched > 0) {
+        for (size_t p = 0; p < prev.Size(); ++p)
+            if (!prevUsed[p]) byAddr.push_back(static_cast<uint32_t>(p));
+        std::sort(byAddr.begin(), byAddr.end(),
+                  [this](uint32_t a, uint32_t b) { return tracked.addrs[a] < tracked.addrs[b]; });
+    }
+    for (size_t k = 0; k < tab.Size() && !byAddr.empty(); ++k) {
+        if (prevRow[k] >= 0) continue;
+        auto it = std::lower_bound(byAddr.begin(), byAddr.end(), addrs[k],
+            [this](uint32_t row, uintptr_t a) { return tracked.addrs[row] < a; });
+        if (it == byAddr.end() || tracked.addrs[*it] != addrs[k]) continue;
+        if (prevUsed[*it]) continue;            // duplicate ref in the list
+        prevRow[k] = static_cast<int32_t>(*it);
+        prevUsed[*it] = 1;
+    }
+
+    // 2. Re-key: the GC moves objects but keeps the list order
+    auto& slotRow = scratch.slotRow;
+    slotRow.clear();
+    for (size_t p = 0; p < prev.Size(); ++p) {
+        if (prevUsed[p]) continue;
+        size_t slot = static_cast<size_t>(tracked.slots[p]);
+        if (slot >= slotRow.size()) slotRow.resize(slot + 1, -1);
+        slotRow[slot] = static_cast<int32_t>(p);
+    }
+    for (size_t k = 0; k < tab.Size() && !slotRow.empty(); ++k) {
+        if (prevRow[k] >= 0 || !tab.Valid(k)) continue;
+        size_t slot = static_cast<size_t>(slots[k]);
+        if (slot >= slotRow.size() || slotRow[slot] < 0) continue;
+
+        int32_t p = slotRow[slot];
+        if (!prev.Valid(p) ||
+            std::abs(prev.posX[p] - tab.posX[k]) > kRekeyDistance ||
+            std::abs(prev.posY[p] - tab.posY[k]) > kRekeyDistance ||
+            std::abs(prev.posZ[p] - tab.posZ[k]) > kRekeyDistance)
+            continue;
+        prevRow[k]  = p;
+        prevUsed[p] = 1;
+        slotRow[slot] = -1;
+        ++delta.rekeyed;
+    }
+
+    // 3. Ids and the delta.  Sized for the worst case up front, so a
+    //    tick where more rows move than ever before doesn't allocate.
+    delta.entered.reserve(tab.Size());
+    delta.moved.reserve(tab.Size());
+    delta.left.reserve(prev.Size());
+    for (size_t k = 0; k < tab.Size(); ++k) {
+        int32_t p = prevRow[k];
+        if (p < 0) {
+            tab.id[k] = tracked.nextId++;
+            delta.entered.push_back(tab.id[k]);
+            continue;
+        }
+        tab.id[k] = prev.id[p];
+        if (prev.posX[p] != tab.posX[k] || prev.posY[p] != tab.posY[k] ||
+            prev.posZ[p] != tab.posZ[k])
+            delta.moved.push_back(tab.id[k]);
+    }
+    for (size_t p = 0; p < prev.Size(); ++p)
+        if (!prevUsed[p]) delta.left.push_back(prev.id[p]);
+}
+
+void EntityReader::TrackEntities(const EntityTable& tab)
+{
+    tracked.table = tab;
+    tracked.addrs.swap(scratch.entityAddrs);     // scratch is rebuilt next tick
+    tracked.slots.swap(scratch.indices);
+    tracked.boxAddrs.swap(scratch.rowBoxAddrs);
+    tracked.klasses.swap(scratch.rowKlass);
+    tracked.boxKlasses.swap(scratch.rowBoxKlass);
+}
+
+template <typename T>
+static size_t CapacityBytes(const std::vector<T>& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+static size_t CapacityBytes(const EntityTable& t)
+{
+    return CapacityBytes(t.id) + CapacityBytes(t.flags) +
+           CapacityBytes(t.posX) + CapacityBytes(t.posY) + CapacityBytes(t.posZ) +
+           CapacityBytes(t.bbMinX) + CapacityBytes(t.bbMinY) + CapacityBytes(t.bbMinZ) +
+           CapacityBytes(t.bbMaxX) + CapacityBytes(t.bbMaxY) + CapacityBytes(t.bbMaxZ);
+}
+
+size_t EntityReader::MeasureArena() const
+{
+    const auto& s = scratch;
+    size_t bytes =
+        CapacityBytes(s.refBytes) + CapacityBytes(s.indices) +
+        CapacityBytes(s.entityAddrs) + CapacityBytes(s.entityBytes) +
+        CapacityBytes(s.boxBytes) + CapacityBytes(s.rowBoxAddrs) +
+        CapacityBytes(s.withBox) + CapacityBytes(s.boxAddrs) +
+        CapacityBytes(s.prevRow) + CapacityBytes(s.prevUsed) +
+        CapacityBytes(s.slotRow) + CapacityBytes(s.byAddr) + CapacityBytes(s.batch) +
+        CapacityBytes(s.listBytes) + CapacityBytes(s.rowKlass) +
+        CapacityBytes(s.rowBoxKlass);
+
+    bytes += CapacityBytes(tracked.table) + CapacityBytes(tracked.addrs) +
+             CapacityBytes(tracked.slots) + CapacityBytes(tracked.boxAddrs) +
+             CapacityBytes(tracked.klasses) + CapacityBytes(tracked.boxKlasses);
+
+    // The published slots are copies of `current` and converge to its
+    // capacity; they belong to the reader thread, so estimate them.
+    const auto& d = current.delta;
+    size_t snapshot = CapacityBytes(current.entities) + CapacityBytes(d.entered) +
+                      CapacityBytes(d.left) + CapacityBytes(d.moved);
+    return bytes + 4 * snapshot;
+}
+
+void EntityReader::ForgetEntities()
+{
+    for (int32_t id : tracked.table.id)
+        current.delta.left.push_back(id);
+
+    current.entities.Clear();
+    tracked.table.Clear();
+    tracked.addrs.clear();
+    tracked.slots.clear();
+    tracked.boxAddrs.clear();
+    tracked.klasses.clear();
+    tracked.boxKlasses.clear();
+}
+
 // =====================================================================
 //  String scan: find known class names in JVM heap/metaspace
 // =====================================================================
@@ -151,47 +601,44 @@ uintptr_t EntityReader::FollowChain() const
 void EntityReader::DoStringScan()
 {
     std::vector<StringFind> results;
+    constexpr size_t sigCount = sizeof(kClassSignatures) / sizeof(kClassSignatures[0]);
 
-    std::cout << "[entity] Scanning for " << (sizeof(kClassSignatures) / sizeof(kClassSignatures[0]))
+    std::cout << "[entity] Scanning for " << sigCount
               << " known class-name signatures...\n";
 
-    for (const char* sig : kClassSignatures) {
-        // Convert the string to a byte pattern (all exact matches)
-        std::string patStr;
-        for (const char* p = sig; *p; ++p) {
-            char hex[4];
-            snprintf(hex, sizeof(hex), "%02X ", static_cast<unsigned char>(*p));
-            patStr += hex;
-        }
+    // Each string is an all-exact byte pattern
+    std::vector<ParsedPattern> patterns;
+    for (const char* sig : kClassSignatures)
+        patterns.push_back(PatternFromString(sig));
 
-        auto pat = ParsePattern(patStr);
-        auto hits = PatternScan(hProcess, pat);
+    // One pass over the address space for all signatures
+    auto hits = PatternScanMulti(*mem, patterns);
 
-        for (auto& h : hits) {
-            StringFind sf;
-            sf.address = h.address;
-            sf.text    = sig;
-            results.push_back(sf);
-        }
+    size_t perSig[sigCount] = {};
+    uintptr_t firstHit[sigCount] = {};
+    for (auto& h : hits) {
+        StringFind sf;
+        sf.address = h.address;
+        sf.text    = kClassSignatures[h.patternId];
+        results.push_back(sf);
 
-        if (!hits.empty()) {
-            std::cout << "[entity]   \"" << sig << "\" -> "
-                      << hits.size() << " hit(s), first at 0x"
-                      << std::hex << hits[0].address << std::dec << "\n";
-        }
+        if (perSig[h.patternId]++ == 0)
+            firstHit[h.patternId] = h.address;
+    }
 
-        // Bail early if thread is stopping
-        if (!running.load()) break;
+    for (size_t i = 0; i < sigCount; ++i) {
+        if (perSig[i] == 0) continue;
+        std::cout << "[entity]   \"" << kClassSignatures[i] << "\" -> "
+                  << perSig[i] << " hit(s), first at 0x"
+                  << std::hex << firstHit[i] << std::dec << "\n";
     }
 
     std::cout << "[entity] String scan complete: " << results.size()
               << " total hits\n";
 
-    {
-        std::lock_guard<std::mutex> lk(mtx);
-        stringFinds = std::move(results);
-        status = "String scan done (" + std::to_string(stringFinds.size()) + " hits)";
-    }
+    std::string done = "String scan done (" + std::to_string(results.size()) + " hits)";
+    stringFinds.store(std::make_shared<const std::vector<StringFind>>(std::move(results)));
+    PublishStatus(done.c_str());
 }
 
 // =====================================================================
@@ -200,118 +647,310 @@ void EntityReader::DoStringScan()
 
 void EntityReader::DoEntityRead()
 {
-    // 1. Follow pointer chain to reach the entity list object
-    uintptr_t listAddr = FollowChain();
-    if (listAddr == 0) {
-        std::lock_guard<std::mutex> lk(mtx);
-        status = "Chain resolved to NULL";
-        entities.clear();
-        return;
+    if (!mem) return;
+
+    // Every typed read below goes through the page cache; a fresh
+    // generation per tick means each page is fetched once per tick.
+    auto t0 = std::chrono::steady_clock::now();
+
+    SyncKlasses();
+
+    current.timings = {};
+    cache.NewGeneration();
+    pool.NewGeneration();
+    auto lastCaptured = current.captured;
+    if (!DoEntityReadWith(cache)) {
+        // The GC moved the heap under the cached chain: walk it again
+        // and read the tick afresh
+        current.timings.rejected = 0;
+        chain.valid = false;
+        cache.NewGeneration();
+        pool.NewGeneration();
+        if (!DoEntityReadWith(cache)) {
+            // Still mid-copy: keep showing the last good rows
+            current.entities = tracked.table;
+            current.captured = lastCaptured;
+            current.status   = "Heap is being relocated (GC), kept last rows";
+        }
     }
 
-    // 2. Read entity count from the list (ArrayList.size is an int)
-    auto countOpt = ReadMemory<int32_t>(hProcess, listAddr + offsets.listSizeOffset);
-    if (!countOpt) {
-        std::lock_guard<std::mutex> lk(mtx);
-        status = "Failed to read entity count";
-        entities.clear();
-        return;
+    current.timings.totalUs = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - t0).count();
+    Publish();
+    arenaBytes.store(MeasureArena());
+}
+
+// elementData is read in chunks of this many bytes
+static constexpr size_t kSliceChunkBytes = CachedMemorySource::kPageSize;
+
+// Entities printed to the console per report
+static constexpr int kPrintRows = 16;
+
+template <typename Source>
+bool EntityReader::DoEntityReadWith(Source& src)
+{
+    // Stage boundaries; each lap is charged to the stage just finished
+    auto& t = current.timings;
+    auto lap = [clock = std::chrono::steady_clock::now()]() mutable {
+        auto now = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(now - clock).count();
+        clock = now;
+        return us;
+    };
+
+    // 1-3. Entity list object (pointer chain, usually cached), its
+    //      size (ArrayList.size) and elementData ref
+    uintptr_t listAddr = 0, arrayRef = 0;
+    int count = 0;
+    if (const char* failed = ReadListHeader(src, listAddr, count, arrayRef)) {
+        current.status = failed;
+        ForgetEntities();
+        return true;
     }
 
-    int count = *countOpt;
     if (count < 0 || count > offsets.maxEntities)
         count = (count < 0) ? 0 : offsets.maxEntities;
 
-    // 3. Read the internal array reference (ArrayList.elementData)
-    uintptr_t arrayRef = ReadOop(listAddr + offsets.listArrayOffset);
-    if (arrayRef == 0) {
-        std::lock_guard<std::mutex> lk(mtx);
-        status = "Entity array ref is NULL";
-        entities.clear();
-        return;
+    t.chainUs = lap();
+
+    auto& batch = scratch.batch;
+    batch.clear();
+    auto add = [&batch](uintptr_t addr, void* dst, size_t size) {
+        ReadRequest r;
+        r.address = addr;
+        r.dst     = dst;
+        r.size    = size;
+        batch.push_back(r);
+    };
+
+    // 4. elementData: its header and the ref slice, in page-sized
+    //    chunks in one batch.  Chunks stay under the cache's bypass
+    //    size, and an unreadable chunk only loses its own refs.
+    const size_t refSize   = oops.RefSize();
+    const size_t klassSize = oops.KlassSize();
+    const size_t header    = offsets.arrayDataOffset;
+    const size_t chunkRefs = kSliceChunkBytes / refSize;
+    const size_t refs      = static_cast<size_t>(count);
+    auto& refBytes = scratch.refBytes;
+    refBytes.resize(header + refs * refSize);
+    for (size_t at = 0; at == 0 || at < refs; at += chunkRefs) {
+        size_t begin = (at == 0) ? 0 : header + at * refSize;
+        size_t end   = header + std::min(at + chunkRefs, refs) * refSize;
+        add(arrayRef + begin, refBytes.data() + begin, end - begin);
+    }
+    src.ReadBatch(batch.data(), batch.size());
+
+    // A forwarded array, or one of another klass than on earlier ticks,
+    // means the list was relocated after we read its elementData ref
+    if (batch[0].ok && header >= 8) {
+        uint64_t mark = 0, klass = 0;
+        std::memcpy(&mark, refBytes.data(), 8);
+        if (static_cast<size_t>(oops.klassOffset) + klassSize <= header)
+            std::memcpy(&klass, refBytes.data() + oops.klassOffset, klassSize);
+        if (Forwarded(mark) || (chain.arrayKlass != 0 && klass != chain.arrayKlass)) {
+            t.relocated = true;
+            return false;
+        }
+        chain.arrayKlass = klass;
     }
 
-    // 4. Walk the array and read each entity
-    std::vector<EntityData> snapshot;
-    snapshot.reserve(count);
+    auto& indices     = scratch.indices;
+    auto& entityAddrs = scratch.entityAddrs;
+    indices.clear();
+    entityAddrs.clear();
 
-    int refSize = oops.compressed ? 4 : 8;
-    int validCount = 0;
+    for (size_t i = 0; i < refs; ++i) {
+        if (!batch[i / chunkRefs].ok) continue;
+        uint64_t raw = 0;
+        std::memcpy(&raw, refBytes.data() + header + i * refSize, refSize);
+        uintptr_t entityAddr = DecodeOop(raw);
+        if (entityAddr == 0) continue;
 
-    for (int i = 0; i < count; ++i) {
-        // Array element address: arrayBase + dataOffset + i * refSize
-        uintptr_t elemAddr = arrayRef + offsets.arrayDataOffset + (i * refSize);
+        indices.push_back(static_cast<int32_t>(i));
+        entityAddrs.push_back(entityAddr);
+    }
 
-        // Dereference to get the Entity object address
-        uintptr_t entityAddr = ReadOop(elemAddr);
-        if (entityAddr == 0) continue;
+    auto& tab = current.entities;
+    tab.Resize(0);
+    tab.Resize(indices.size());        // zeroed rows; ids come from IdentifyEntities()
+    t.sliceUs = lap();
+
+    // Each level below is one ReadBatch: all reads of a level are
+    // independent, only the next level depends on them.  Large levels
+    // are split across the fetch pool.
+
+    // 5. Level 1: each Entity object in one read of the span covering
+    //    its header, position doubles and Box ref; fields are decoded
+    //    and checked locally
+    const ObjectSpan es = offsets.EntitySpan(oops);
+    const ObjectSpan bs = offsets.BoxSpan(oops);
+
+    auto& entityBytes = scratch.entityBytes;
+    entityBytes.resize(tab.Size() * es.size);
+    batch.reserve(tab.Size());
+    batch.clear();
+    for (size_t k = 0; k < tab.Size(); ++k)
+        add(entityAddrs[k] + es.begin, entityBytes.data() + k * es.size, es.size);
+    pool.ReadBatch(src, batch.data(), batch.size());
+    current.captured = std::chrono::steady_clock::now();
+
+    // Field at `offset` within an object whose span was read to `obj`
+    auto field = [](const uint8_t* obj, const ObjectSpan& span, int offset,
+                    void* out, size_t size) {
+        std::memcpy(out, obj + (offset - span.begin), size);
+    };
 
-        EntityData ed;
-        ed.index = i;
-
-        // Read position doubles
-        auto px = ReadMemory<double>(hProcess, entityAddr + offsets.posXOffset);
-        auto py = ReadMemory<double>(hProcess, entityAddr + offsets.posYOffset);
-        auto pz = ReadMemory<double>(hProcess, entityAddr + offsets.posZOffset);
-
-        if (px && py && pz) {
-            ed.posX = *px;
-            ed.posY = *py;
-            ed.posZ = *pz;
-
-            // Sanity check: positions should be finite and within MC world bounds
-            if (ed.posX > -3.0e7 && ed.posX < 3.0e7 &&
-                ed.posY > -1000   && ed.posY < 1000 &&
-                ed.posZ > -3.0e7 && ed.posZ < 3.0e7)
-            {
-                ed.valid = true;
-            }
+    int validCount = 0;
+    int forwarded  = 0;
+    int foreign    = 0;
+    auto& rowBoxAddrs = scratch.rowBoxAddrs;
+    auto& rowKlass    = scratch.rowKlass;
+    auto& rowBoxKlass = scratch.rowBoxKlass;
+    rowBoxAddrs.assign(tab.Size(), 0);
+    rowKlass.assign(tab.Size(), 0);
+    rowBoxKlass.assign(tab.Size(), 0);
+    for (size_t k = 0; k < tab.Size(); ++k) {
+        if (!batch[k].ok) continue;
+
+        // Header first: an old copy the GC moved away from is garbage
+        const uint8_t* obj = entityBytes.data() + k * es.size;
+        uint64_t mark = 0;
+        field(obj, es, 0, &mark, sizeof(mark));
+        if (Forwarded(mark)) {
+            tab.flags[k] |= entity_flag::Rejected;
+            ++forwarded;
+            continue;
+        }
+        // ... and so is an object of a klass not expected in the list
+        // (a stale ref, or a wrong offset somewhere in the chain)
+        field(obj, es, oops.klassOffset, &rowKlass[k], klassSize);
+        if (!entityKlasses.Accepts(rowKlass[k])) {
+            tab.flags[k] |= entity_flag::Rejected;
+            ++foreign;
+            continue;
         }
 
-        // Read bounding box (optional — follow ref to Box object)
-        uintptr_t bbAddr = ReadOop(entityAddr + offsets.bbRefOffset);
-        if (bbAddr != 0) {
-            auto bx0 = ReadMemory<double>(hProcess, bbAddr + offsets.bbMinXOffset);
-            auto by0 = ReadMemory<double>(hProcess, bbAddr + offsets.bbMinYOffset);
-            auto bz0 = ReadMemory<double>(hProcess, bbAddr + offsets.bbMinZOffset);
-            auto bx1 = ReadMemory<double>(hProcess, bbAddr + offsets.bbMaxXOffset);
-            auto by1 = ReadMemory<double>(hProcess, bbAddr + offsets.bbMaxYOffset);
-            auto bz1 = ReadMemory<double>(hProcess, bbAddr + offsets.bbMaxZOffset);
-
-            if (bx0) ed.bbMinX = *bx0;
-            if (by0) ed.bbMinY = *by0;
-            if (bz0) ed.bbMinZ = *bz0;
-            if (bx1) ed.bbMaxX = *bx1;
-            if (by1) ed.bbMaxY = *by1;
-            if (bz1) ed.bbMaxZ = *bz1;
+        field(obj, es, offsets.posXOffset, &tab.posX[k], sizeof(double));
+        field(obj, es, offsets.posYOffset, &tab.posY[k], sizeof(double));
+        field(obj, es, offsets.posZOffset, &tab.posZ[k], sizeof(double));
+
+        // Sanity check: positions should be finite and within MC world bounds
+        if (tab.posX[k] > -3.0e7 && tab.posX[k] < 3.0e7 &&
+            tab.posY[k] > -1000   && tab.posY[k] < 1000 &&
+            tab.posZ[k] > -3.0e7 && tab.posZ[k] < 3.0e7)
+        {
+            tab.flags[k] |= entity_flag::Valid;
+            ++validCount;
         }
 
-        snapshot.push_back(ed);
-        if (ed.valid) ++validCount;
+        // Bounding box is optional — only follow non-null refs
+        uint64_t bbRef = 0;
+        field(obj, es, offsets.bbRefOffset, &bbRef, refSize);
+        rowBoxAddrs[k] = DecodeOop(bbRef);
     }
 
-    // 5. Console output for valid entities
+    // Enough forwarded objects: the list itself is stale.  Bail out
+    // before any tracking state changes; DoEntityRead() re-walks.
+    if (forwarded > 0 && forwarded * kRelocatedShare >= static_cast<int>(tab.Size())) {
+        t.relocated = true;
+        return false;
+    }
+    t.rejected = forwarded + foreign;
+
+    // Ids, delta; then a Box is only read again if its entity moved or
+    // now points at a different Box object
+    IdentifyEntities(tab);
+
+    auto& withBox  = scratch.withBox;
+    auto& boxAddrs = scratch.boxAddrs;
+    withBox.clear();
+    boxAddrs.clear();
+    const auto& prev = tracked.table;
+    for (size_t k = 0; k < tab.Size(); ++k) {
+        uintptr_t bbAddr = rowBoxAddrs[k];
+        if (bbAddr == 0) continue;
+
+        int32_t p = scratch.prevRow[k];
+        if (p >= 0 && (prev.flags[p] & entity_flag::HasBox) &&
+            tracked.boxAddrs[p] == bbAddr && boxKlasses.Accepts(tracked.boxKlasses[p]) &&
+            prev.posX[p] == tab.posX[k] && prev.posY[p] == tab.posY[k] &&
+            prev.posZ[p] == tab.posZ[k])
+        {
+            tab.bbMinX[k] = prev.bbMinX[p];
+            tab.bbMinY[k] = prev.bbMinY[p];
+            tab.bbMinZ[k] = prev.bbMinZ[p];
+            tab.bbMaxX[k] = prev.bbMaxX[p];
+            tab.bbMaxY[k] = prev.bbMaxY[p];
+            tab.bbMaxZ[k] = prev.bbMaxZ[p];
+            tab.flags[k] |= entity_flag::HasBox;
+            rowBoxKlass[k] = tracked.boxKlasses[p];
+            ++t.boxesReused;
+            continue;
+        }
+        withBox.push_back(k);
+        boxAddrs.push_back(bbAddr);
+    }
+    t.entitiesUs = lap();
+    t.entities   = static_cast<int>(tab.Size());
+
+    // 6. Level 2: each Box that has to be read, in one read of its
+    //    header and six doubles
+    auto& boxBytes = scratch.boxBytes;
+    boxBytes.resize(withBox.size() * bs.size);
+    batch.clear();
+    for (size_t j = 0; j < withBox.size(); ++j)
+        add(boxAddrs[j] + bs.begin, boxBytes.data() + j * bs.size, bs.size);
+    pool.ReadBatch(src, batch.data(), batch.size());
+
+    for (size_t j = 0; j < withBox.size(); ++j) {
+        if (!batch[j].ok) continue;            // failed boxes stay 0
+        size_t k = withBox[j];
+        const uint8_t* obj = boxBytes.data() + j * bs.size;
+
+        // Same header check: a wrong bbRefOffset or a stale ref lands
+        // on some other object, whose klass isn't an expected Box's
+        uint64_t mark = 0, klass = 0;
+        field(obj, bs, 0, &mark, sizeof(mark));
+        field(obj, bs, oops.klassOffset, &klass, klassSize);
+        if (Forwarded(mark) || !boxKlasses.Accepts(klass)) {
+            ++t.rejected;
+            continue;
+        }
+        rowBoxKlass[k] = klass;
+
+        field(obj, bs, offsets.bbMinXOffset, &tab.bbMinX[k], sizeof(double));
+        field(obj, bs, offsets.bbMinYOffset, &tab.bbMinY[k], sizeof(double));
+        field(obj, bs, offsets.bbMinZOffset, &tab.bbMinZ[k], sizeof(double));
+        field(obj, bs, offsets.bbMaxXOffset, &tab.bbMaxX[k], sizeof(double));
+        field(obj, bs, offsets.bbMaxYOffset, &tab.bbMaxY[k], sizeof(double));
+        field(obj, bs, offsets.bbMaxZOffset, &tab.bbMaxZ[k], sizeof(double));
+        tab.flags[k] |= entity_flag::HasBox;
+    }
+    t.boxesUs = lap();
+    t.boxes   = static_cast<int>(withBox.size());
+
+    TrackEntities(tab);
+
+    // 7. Console output for the first few valid entities
     static int printCooldown = 0;
-    if (++printCooldown >= 20) {  // print every ~1 second (20 * 50ms)
+    if (printEntities && ++printCooldown >= 20) {  // print every ~1 second (20 * 50ms)
         printCooldown = 0;
-        for (auto& e : snapshot) {
-            if (e.valid) {
+        int printed = 0;
+        for (size_t k = 0; k < tab.Size() && printed < kPrintRows; ++k) {
+            if (tab.Valid(k)) {
+                ++printed;
                 printf("Entity #%d at X:%.2f Y:%.2f Z:%.2f\n",
-                       e.index, e.posX, e.posY, e.posZ);
+                       tab.id[k], tab.posX[k], tab.posY[k], tab.posZ[k]);
             }
         }
         if (validCount > 0)
             printf("--- %d/%d entities valid ---\n\n", validCount, count);
     }
 
-    // 6. Publish snapshot
-    {
-        std::lock_guard<std::mutex> lk(mtx);
-        entities = std::move(snapshot);
-
-        char buf[128];
-        snprintf(buf, sizeof(buf), "Reading %d entities (%d valid) @ 0x%llX",
-                 count, validCount, static_cast<unsigned long long>(listAddr));
-        status = buf;
-    }
+    // 8. Status line; DoEntityRead() publishes
+    char buf[128];
+    snprintf(buf, sizeof(buf), "Reading %d entities (%d valid, %d rejected) @ 0x%llX",
+             count, validCount, t.rejected, static_cast<unsigned long long>(listAddr));
+    current.status = buf;
+    return true;
 }
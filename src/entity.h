@@ -1,22 +1,64 @@
 #pragma once
 
-#include <Windows.h>
+#include "memory_source.h"
+#include "read_cache.h"
+#include "fetch_pool.h"
+#include "triple_buffer.h"
+#include "tick_scheduler.h"
+
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <atomic>
 
-// ── Entity position + bounding box read from JVM heap ────────────────
-struct EntityData {
-    int    index = 0;
-    double posX = 0, posY = 0, posZ = 0;
-    double bbMinX = 0, bbMinY = 0, bbMinZ = 0;
-    double bbMaxX = 0, bbMaxY = 0, bbMaxZ = 0;
-    bool   valid = false;
+// ── Entity positions + bounding boxes read from JVM heap ─────────────
+// Structure of arrays: one contiguous array per field, all the same
+// length, row i being one entity.  Consumers that touch a few fields
+// (distance culling, the panel list) stream just those arrays.
+
+namespace entity_flag {
+    constexpr uint8_t Valid    = 0x01;  // position passed the sanity check
+    constexpr uint8_t HasBox   = 0x02;  // bbMin/bbMax were read
+    constexpr uint8_t Rejected = 0x04;  // header check failed: moved by the GC, or not an expected klass
+}
+
+struct EntityTable {
+    std::vector<int32_t> id;            // stable per-entity id (see EntityReader)
+    std::vector<uint8_t> flags;         // entity_flag::*
+    std::vector<double>  posX, posY, posZ;
+    std::vector<double>  bbMinX, bbMinY, bbMinZ;
+    std::vector<double>  bbMaxX, bbMaxY, bbMaxZ;
+
+    size_t Size() const { return id.size(); }
+    bool   Valid(size_t i) const { return flags[i] & entity_flag::Valid; }
+
+    // Resize every column; new rows are zero.
+    void Resize(size_t n);
+    void Clear() { Resize(0); }
+};
+
+// Same rows as floats relative to a camera position.  The subtraction
+// is done in double, so precision is lost only with distance from the
+// camera, not from the world origin.
+struct EntityTableF {
+    std::vector<int32_t> id;
+    std::vector<uint8_t> flags;
+    std::vector<float>   x, y, z;
+    std::vector<float>   minX, minY, minZ;
+    std::vector<float>   maxX, maxY, maxZ;
+
+    size_t Size() const { return id.size(); }
 };
 
+// Fill `out` with `in` relative to (camX, camY, camZ).  `out` keeps
+// its capacity, so a per-frame call doesn't allocate in steady state.
+void ToCameraRelative(const EntityTable& in, double camX, double camY, double camZ,
+                      EntityTableF& out);
+
 // ── JVM string found during class-name scan ──────────────────────────
 struct StringFind {
     uintptr_t   address = 0;
@@ -30,6 +72,77 @@ struct OopConfig {
     bool      compressed = true;   // true = 4-byte refs shifted
     int       shift      = 3;      // usually 3
     uintptr_t heapBase   = 0;      // usually 0
+
+    // Object header: mark word at +0, then the klass pointer — 4 bytes
+    // with compressed class pointers (the default), else 8.
+    int       klassOffset     = 8;
+    bool      compressedKlass = true;
+
+    int RefSize() const   { return compressed ? 4 : 8; }
+    int KlassSize() const { return compressedKlass ? 4 : 8; }
+};
+
+// ── Byte range of an object that covers a set of its fields ──────────
+struct ObjectSpan {
+    int begin = 0;      // offset of the first byte
+    int size  = 0;      // bytes from `begin` through the last field
+};
+
+// ── Per-stage timing of one entity read tick ─────────────────────────
+// A tick is a fixed number of dependent stages, each one batched read,
+// so its latency tracks the stage count rather than the entity count.
+struct EntityReadTimings {
+    double chainUs    = 0;      // pointer chain, list size, elementData ref
+    int    chainReads = 0;      // reads that took: 1 while the chain is cached
+    double sliceUs    = 0;      // elementData slice read + oop decode
+    double entitiesUs = 0;      // Entity object fetch + decode
+    double boxesUs    = 0;      // Box object fetch + decode
+    double totalUs    = 0;      // whole tick, including publish
+    int    entities   = 0;      // objects fetched by the two object stages
+    int    boxes      = 0;
+    int    boxesReused = 0;     // Box not re-read: entity didn't move
+    int    rejected   = 0;      // objects dropped by the header check
+    bool   relocated  = false;  // a GC moved the heap: chain re-walked, tick re-read
+};
+
+// ── Changes between two consecutive snapshots ────────────────────────
+// Ids are EntityTable::id.  A consumer that saw snapshot `base` can
+// apply this delta instead of diffing tables; if it missed one (its
+// last sequence != base) it resyncs from the full table.
+struct EntityDelta {
+    uint64_t             base = 0;  // sequence this delta applies on top of
+    std::vector<int32_t> entered;   // new this snapshot
+    std::vector<int32_t> left;      // gone since `base`
+    std::vector<int32_t> moved;     // position changed
+    int                  rekeyed = 0;   // kept their id across a GC move
+};
+
+// ── Everything the reader publishes after a tick ─────────────────────
+struct EntitySnapshot {
+    uint64_t                sequence = 0;   // bumped by every publish
+    std::chrono::steady_clock::time_point captured{};  // when `entities` positions were read
+    EntityTable             entities;
+    EntityDelta             delta;          // from the previous snapshot
+    EntityReadTimings       timings;        // of the tick that read `entities`
+    int                     entityKlasses = 0;  // expected klasses in force (0: not checked)
+    int                     boxKlasses    = 0;
+    std::string             status = "idle";
+};
+
+// ── Pointer chain: base -> [off0] -> [off1] -> ... -> entity list ───
+// base is an absolute address (e.g., MinecraftClient static).  Each
+// hop is dereferenced as a pointer, adding the next offset.
+struct EntityChain {
+    uintptr_t          base = 0;
+    std::vector<int>   offsets;             // e.g. {0x10, 0x48, 0x20}
+};
+
+// ── Expected klass words of Entity / Box objects ─────────────────────
+// Header words as read (compressed or full, per OopConfig).  A row or
+// Box of any other klass is rejected; an empty list checks nothing.
+struct EntityKlasses {
+    std::vector<uint64_t> entity;
+    std::vector<uint64_t> box;
 };
 
 // ── Offsets for reading entity data from JVM objects ─────────────────
@@ -37,12 +150,6 @@ struct OopConfig {
 // These MUST be discovered per-version (Cheat Engine / experimentation).
 // Defaults are placeholder starting points for 1.21.x HotSpot x64.
 struct EntityOffsets {
-    // ── Pointer chain: base -> [off0] -> [off1] -> ... -> entity list ─
-    // chainBase is an absolute address (e.g., MinecraftClient static).
-    // Each chainOffset is dereferenced as an oop, adding the next offset.
-    uintptr_t          chainBase    = 0;
-    std::vector<int>   chainOffsets;        // e.g. {0x10, 0x48, 0x20}
-
     // ── Entity list (Java ArrayList or similar) ──────────────────────
     int listSizeOffset  = 0x10;   // ArrayList.size     (int, 4 bytes)
     int listArrayOffset = 0x14;   // ArrayList.elementData (oop ref)
@@ -68,8 +175,16 @@ struct EntityOffsets {
     int bbMaxYOffset = 0x30;      // double Box.maxY
     int bbMaxZOffset = 0x38;      // double Box.maxZ
 
-    // Maximum entities to read (safety cap)
-    int maxEntities = 256;
+    // Maximum entities to read.  Only a safety cap against a garbage
+    // list size: busy servers and farms hold thousands of entities.
+    int maxEntities = 16384;
+
+    // Smallest span covering the object header (mark + klass) and the
+    // Entity fields (position + Box ref) / the six Box doubles.  The
+    // reader fetches each object with one read of its span and decodes
+    // and validates it locally.
+    ObjectSpan EntitySpan(const OopConfig& oops) const;
+    ObjectSpan BoxSpan(const OopConfig& oops) const;
 };
 
 // =====================================================================
@@ -80,41 +195,92 @@ public:
     EntityReader() = default;
     ~EntityReader();
 
-    // Start the background read loop targeting `process`.
-    void Start(HANDLE process);
+    // Start the background read loop reading through `source`.
+    // The source must outlive the reader (or the next Stop()).
+    void Start(MemorySource& source);
 
     // Stop the background thread.
     void Stop();
 
     bool IsRunning() const { return running.load(); }
 
-    // ── Thread-safe accessors ────────────────────────────────────────
+    // ── Accessors ────────────────────────────────────────────────────
+
+    // Latest published snapshot (entities, timings, status), triple
+    // buffered: no lock, no copy.  For ONE consumer thread (the render
+    // loop); the reference stays valid until that thread's next call.
+    const EntitySnapshot& AcquireSnapshot();
+
+    // True if a snapshot was published since the last AcquireSnapshot().
+    bool HasNewSnapshot() const { return published.Fresh(); }
+
+    // String-scan results (class name discovery); replaced as a whole
+    // by each scan, so holding the pointer is safe from any thread.
+    std::shared_ptr<const std::vector<StringFind>> GetStringFinds() const;
+
+    // Page-cache counters of the entity read path (all fetch threads).
+    CachedMemorySource::Stats GetCacheStats() const;
 
-    // Latest entity snapshot.
-    std::vector<EntityData> GetEntities() const;
+    // Threads the running reader splits large fetches across.
+    int FetchThreads() const { return pool.Threads(); }
 
-    // String-scan results (class name discovery).
-    std::vector<StringFind> GetStringFinds() const;
+    // Bytes held by the reader's reused per-tick storage: scratch,
+    // tracking, the working snapshot and the three published slots.
+    // Grows to the largest entity count seen, then stays put.
+    size_t ArenaBytes() const { return arenaBytes.load(); }
 
-    // Status message for display.
-    std::string GetStatus() const;
+    // Achieved read rate, period jitter and busy fraction.
+    TickScheduler::Stats GetScheduleStats() const { return scheduler.GetStats(); }
 
     // ── Commands (set flags, worker picks them up) ───────────────────
 
     // Request a one-shot string scan for JVM class names.
     void RequestStringScan();
 
+    // Switch continuous entity reads on/off.  While off (and no scan is
+    // pending) the worker blocks instead of waking every interval.
+    void SetReadEnabled(bool on);
+    bool ReadEnabled() const { return entityReadEnabled.load(); }
+
+    // Replace the expected Entity / Box klasses.  Any thread; the
+    // worker adopts them at its next tick.
+    void SetKlasses(EntityKlasses klasses);
+
+    // Expect exactly the klasses of the last published tick's valid
+    // rows and their Boxes.  Call once the table is known to be right.
+    void PinKlasses() { pinKlassesRequested.store(true); }
+
+    // Stop checking klasses (e.g. after changing the header layout).
+    void ForgetKlasses() { SetKlasses({}); }
+
+    // Call once per presented overlay frame (drives FrameAligned).
+    void NotifyFrame() { scheduler.NotifyFrame(); }
+
+    // Replace the pointer chain to the entity list.  Any thread; the
+    // worker picks the new chain up at its next tick.  Nothing is read
+    // while the base is 0.
+    void SetChain(uintptr_t base, std::vector<int> chainOffsets);
+
     // ── Configuration (set before Start, or while running) ───────────
 
     OopConfig      oops;
     EntityOffsets  offsets;
 
-    // Interval between entity reads (ms).
+    // How entity reads are paced (see tick_scheduler.h).
+    ScheduleMode schedule = ScheduleMode::FixedRate;
+
+    // Interval between entity reads (ms), for FixedRate.
     int readIntervalMs = 50;
 
-    // Whether the read loop is actively reading entities.
-    // If false, the thread idles (useful to pause without stopping).
-    std::atomic<bool> entityReadEnabled{ false };
+    // Fraction of the time spent reading, for MaxRate (0..1].
+    float cpuBudget = 0.25f;
+
+    // Threads the object fetch levels are split across when the list
+    // is large (see fetch_pool.h).  Takes effect at Start().
+    int fetchThreads = 4;
+
+    // Print the first few entities to the console about once a second.
+    bool printEntities = true;
 
 private:
     void WorkerLoop();
@@ -125,19 +291,144 @@ private:
     // Continuous: follow pointer chain, read entity list, populate snapshot.
     void DoEntityRead();
 
-    // Dereference a JVM oop (compressed or raw) at `addr`.
-    uintptr_t ReadOop(uintptr_t addr) const;
+    // Adopt a chain published by SetChain() since the last tick (one
+    // atomic load per tick; the config itself only when it changed).
+    // Returns false while no chain is set.
+    bool SyncChain();
+
+    // Adopt klasses from SetKlasses() or a PinKlasses() request, the
+    // same way.
+    void SyncKlasses();
+
+    // The read path, instantiated per concrete source type so reads are
+    // direct calls rather than through the vtable.  Returns false,
+    // having changed no tracking state, if the tick has to be read again
+    // through a freshly walked chain: the headers it read show the GC
+    // relocated the heap under the cached chain (timings.relocated).
+    template <typename Source> bool DoEntityReadWith(Source& src);
+
+    // Decode a raw oop slot value (4-byte compressed ref zero-extended,
+    // or an 8-byte pointer).  Null stays 0.
+    uintptr_t DecodeOop(uint64_t raw) const;
+
+    // Follow the adopted pointer chain from its base through its
+    // offsets, recording every hop in `chain`.  Returns the list
+    // address, or 0 if a hop was unreadable or null.
+    template <typename Source> uintptr_t FollowChain(Source& src);
+
+    // The entity list's address, size and elementData ref.  Uses the
+    // cached chain when its terminal object checks out, else walks it.
+    // Returns nullptr, or the status text of what failed.
+    template <typename Source>
+    const char* ReadListHeader(Source& src, uintptr_t& listAddr, int& count,
+                               uintptr_t& arrayRef);
 
-    // Follow the configured pointer chain from chainBase through offsets.
-    uintptr_t FollowChain() const;
+    // Worker thread: publish `current` with a new sequence number.
+    void Publish();
+    void PublishStatus(const char* text);
+
+    // Give the rows of `tab` their ids (matched against last tick's
+    // rows by address, then by list slot + position for objects the GC
+    // moved) and fill current.delta.  scratch.prevRow gets the matched
+    // previous row per entity, or -1.
+    void IdentifyEntities(EntityTable& tab);
+
+    // Remember this tick's rows for the next IdentifyEntities().
+    void TrackEntities(const EntityTable& tab);
+
+    // The list couldn't be read: everything tracked has left.
+    void ForgetEntities();
+
+    // Capacity of everything ArenaBytes() covers.  Worker thread.
+    size_t MeasureArena() const;
+
+    MemorySource*   mem = nullptr;
+    CachedMemorySource cache;       // entity reads; new generation per tick
+    FetchPool       pool;           // helpers for the large object levels
+    std::atomic<size_t>   arenaBytes{ 0 };
+
+    // Per-tick working storage, kept across ticks so a steady-state
+    // tick allocates nothing.
+    struct TickScratch {
+        std::vector<uint8_t>     refBytes;      // elementData slice, read in chunks
+        std::vector<int32_t>     indices;       // list index per entity
+        std::vector<uintptr_t>   entityAddrs;
+        std::vector<uint8_t>     entityBytes;   // EntitySpan() per entity
+        std::vector<uint8_t>     boxBytes;      // BoxSpan() per Box
+        std::vector<uintptr_t>   rowBoxAddrs;   // Box address per entity (0: none)
+        std::vector<size_t>      withBox;       // entities whose Box is read
+        std::vector<uintptr_t>   boxAddrs;
+        std::vector<int32_t>     prevRow;       // matched row of last tick
+        std::vector<uint8_t>     prevUsed;
+        std::vector<int32_t>     slotRow;       // unmatched last-tick row per slot
+        std::vector<uint32_t>    byAddr;        // unmatched last-tick rows by address
+        std::vector<uint8_t>     listBytes;     // terminal header .. elementData ref
+        std::vector<uint64_t>    rowKlass;      // klass word per entity
+        std::vector<uint64_t>    rowBoxKlass;   // its Box's klass word (0: no Box)
+        std::vector<ReadRequest> batch;
+    } scratch;
+
+    // Resolved pointer chain, kept across ticks.  The hops are only
+    // walked again when the terminal object's klass word no longer
+    // reads back the same (the GC moved it), a read fails, the chain
+    // config changes, or every kChainRecheckTicks ticks.
+    struct ChainCache {
+        std::shared_ptr<const EntityChain> config;  // adopted config (immutable)
+        uint64_t               version = 0;     // chainVersion it was adopted at
+        std::vector<uintptr_t> hops;            // object reached by each dereference
+        uintptr_t              listAddr   = 0;
+        uint64_t               klass      = 0;  // terminal object's klass word
+        uint64_t               arrayKlass = 0;  // elementData's (Object[]), 0: not seen yet
+        int                    age        = 0;  // ticks since the walk
+        bool                   valid      = false;
+    } chain;
+
+    // Last tick's rows; entities keep their id while their object (or,
+    // after a GC move, their list slot and position) stays the same.
+    struct Tracking {
+        EntityTable            table;
+        std::vector<uintptr_t> addrs;       // object address per row
+        std::vector<int32_t>   slots;       // list index per row
+        std::vector<uintptr_t> boxAddrs;    // Box address per row
+        std::vector<uint64_t>  klasses;     // klass word per row
+        std::vector<uint64_t>  boxKlasses;  // Box klass word per row (0: no Box)
+        int32_t                nextId = 1;
+    } tracked;
+
+    // Klass words accepted for Entity / Box objects, as configured or
+    // pinned; never learned from the objects being checked.
+    struct KlassSet {
+        std::vector<uint64_t> klasses;      // sorted, unique; empty: accept all
+
+        bool Accepts(uint64_t klass) const;
+        void Assign(std::vector<uint64_t> words);
+    };
+    KlassSet entityKlasses;
+    KlassSet boxKlasses;
 
-    HANDLE          hProcess = nullptr;
     std::thread     worker;
+    TickScheduler   scheduler;
     std::atomic<bool> running{ false };
     std::atomic<bool> stringScanRequested{ false };
+    std::atomic<bool> entityReadEnabled{ false };
+    std::atomic<bool> pinKlassesRequested{ false };
 
-    mutable std::mutex mtx;
-    std::vector<EntityData> entities;
-    std::vector<StringFind> stringFinds;
-    std::string             status = "idle";
+    // Chain handed over by SetChain(): the config is replaced whole
+    // under chainMtx, then the version bumped, so the worker compares a
+    // counter per tick and only locks when it changed.
+    std::mutex                         chainMtx;
+    std::shared_ptr<const EntityChain> chainConfig;
+    std::atomic<uint64_t>              chainVersion{ 0 };
+
+    // Klasses handed over by SetKlasses(), likewise.
+    std::mutex                           klassMtx;
+    std::shared_ptr<const EntityKlasses> klassConfig;
+    std::atomic<uint64_t>                klassVersion{ 0 };
+    uint64_t                             klassAdopted = 0;   // worker-owned
+
+    // Worker-owned state; copied into the back slot by Publish().
+    EntitySnapshot               current;
+    TripleBuffer<EntitySnapshot> published;
+
+    std::atomic<std::shared_ptr<const std::vector<StringFind>>> stringFinds;
 };
@@ -1,8 +1,10 @@
 #include "esp.h"
 
 #include <imgui.h>
+#include <algorithm>
 #include <cstdio>
 #include <cfloat>
+#include <vector>
 
 static constexpr float DEG2RAD = 3.14159265f / 180.0f;
 
@@ -88,7 +90,7 @@ static Mat4 Multiply(const Mat4& a, const Mat4& b)
 //  Build view matrix from yaw/pitch/position
 // =====================================================================
 
-static Mat4 BuildViewMatrix(const EspConfig& cfg)
+static Mat4 BuildViewMatrix(const EspConfig& cfg, Vec3 eye)
 {
     float yawRad   = cfg.camYaw   * DEG2RAD;
     float pitchRad = cfg.camPitch * DEG2RAD;
@@ -99,13 +101,9 @@ static Mat4 BuildViewMatrix(const EspConfig& cfg)
     float fy = -sinf(pitchRad);
     float fz = -cosf(yawRad) * cosf(pitchRad);
 
-    Vec3 target = {
-        cfg.camPos.x + fx,
-        cfg.camPos.y + fy,
-        cfg.camPos.z + fz
-    };
+    Vec3 target = { eye.x + fx, eye.y + fy, eye.z + fz };
 
-    return Mat4::LookAt(cfg.camPos, target, {0, 1, 0});
+    return Mat4::LookAt(eye, target, {0, 1, 0});
 }
 
 // =====================================================================
@@ -132,11 +130,95 @@ bool WorldToScreen(const Vec3& world, const Mat4& viewProj,
     return true;
 }
 
+// =====================================================================
+//  EntityMotion
+// =====================================================================
+
+// Samples further apart than this are a teleport, not motion.
+static constexpr double kTeleportDistance = 8.0;
+
+void EntityMotion::Update(const EntitySnapshot& snap)
+{
+    if (snap.captured == lastCapture) return;
+    lastCapture = snap.captured;
+
+    const auto& tab = snap.entities;
+    next.resize(tab.Size());
+    for (size_t k = 0; k < tab.Size(); ++k) {
+        Track& tr = next[k];
+        auto it = std::lower_bound(byId.begin(), byId.end(), tab.id[k],
+            [this](uint32_t row, int32_t id) { return tracks[row].id < id; });
+        if (it != byId.end() && tracks[*it].id == tab.id[k]) {
+            tr = tracks[*it];
+        } else {
+            tr.id    = tab.id[k];
+            tr.count = 0;
+        }
+
+        if (!tab.Valid(k)) {            // garbage position: start over
+            tr.count = 0;
+            continue;
+        }
+        if (tr.count == kSamples) {
+            std::move(tr.s + 1, tr.s + kSamples, tr.s);
+            --tr.count;
+        }
+        tr.s[tr.count++] = { snap.captured, tab.posX[k], tab.posY[k], tab.posZ[k] };
+    }
+    tracks.swap(next);
+
+    byId.resize(tracks.size());
+    for (size_t i = 0; i < byId.size(); ++i)
+        byId[i] = static_cast<uint32_t>(i);
+    std::sort(byId.begin(), byId.end(),
+              [this](uint32_t a, uint32_t b) { return tracks[a].id < tracks[b].id; });
+}
+
+void EntityMotion::Apply(const EntityTable& in, std::chrono::steady_clock::time_point at,
+                         float maxExtrapMs, EntityTable& out) const
+{
+    using Seconds = std::chrono::duration<double>;
+
+    out = in;
+    if (tracks.size() != in.Size()) return;     // not the table Update() saw
+
+    const double maxExtrap = std::max(0.0f, maxExtrapMs) / 1000.0;
+    for (size_t k = 0; k < in.Size(); ++k) {
+        const Track& tr = tracks[k];
+        if (tr.id != in.id[k] || tr.count < 2) continue;
+
+        // Pick the segment: the two samples around `at`, or the newest
+        // two when `at` is past them
+        int i = tr.count - 2;
+        while (i > 0 && at < tr.s[i].t) --i;
+        const Sample& a = tr.s[i];
+        const Sample& b = tr.s[i + 1];
+
+        double span = Seconds(b.t - a.t).count();
+        double dx = b.x - a.x, dy = b.y - a.y, dz = b.z - a.z;
+        if (span <= 0 || dx*dx + dy*dy + dz*dz > kTeleportDistance * kTeleportDistance)
+            continue;
+
+        // f in [0, 1] interpolates; f > 1 extrapolates, capped
+        double f = Seconds(at - a.t).count() / span;
+        f = std::clamp(f, 0.0, 1.0 + maxExtrap / span);
+
+        const Sample& newest = tr.s[tr.count - 1];
+        double ox = a.x + dx * f - newest.x;
+        double oy = a.y + dy * f - newest.y;
+        double oz = a.z + dz * f - newest.z;
+
+        out.posX[k]   += ox;  out.posY[k]   += oy;  out.posZ[k]   += oz;
+        out.bbMinX[k] += ox;  out.bbMinY[k] += oy;  out.bbMinZ[k] += oz;
+        out.bbMaxX[k] += ox;  out.bbMaxY[k] += oy;  out.bbMaxZ[k] += oz;
+    }
+}
+
 // =====================================================================
 //  DrawEntityESP
 // =====================================================================
 
-void DrawEntityESP(const std::vector<EntityData>& entities,
+void DrawEntityESP(const EntityTable& entities,
                    const EspConfig& cfg,
                    float screenX, float screenY,
                    float screenW, float screenH)
@@ -144,9 +226,28 @@ void DrawEntityESP(const std::vector<EntityData>& entities,
     if (!cfg.enabled || screenW <= 0 || screenH <= 0)
         return;
 
+    // Everything below works camera-relative: the camera sits at the
+    // origin and entities are float offsets from it
+    thread_local EntityTableF rel;
+    thread_local std::vector<float>    dist2;
+    thread_local std::vector<uint32_t> visible;
+    ToCameraRelative(entities, cfg.camPos.x, cfg.camPos.y, cfg.camPos.z, rel);
+
+    // ── Distance cull: one pass over three contiguous columns ────────
+    const size_t n = rel.Size();
+    dist2.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        dist2[i] = rel.x[i]*rel.x[i] + rel.y[i]*rel.y[i] + rel.z[i]*rel.z[i];
+
+    const float maxDist2 = cfg.maxDrawDist * cfg.maxDrawDist;
+    visible.clear();
+    for (size_t i = 0; i < n; ++i)
+        if ((rel.flags[i] & entity_flag::Valid) && dist2[i] <= maxDist2)
+            visible.push_back(static_cast<uint32_t>(i));
+
     // Build view-projection matrix
     float aspect = screenW / screenH;
-    Mat4 view = BuildViewMatrix(cfg);
+    Mat4 view = BuildViewMatrix(cfg, {0, 0, 0});
     Mat4 proj = Mat4::PerspectiveFov(cfg.fovY * DEG2RAD, aspect,
                                       cfg.zNear, cfg.zFar);
     Mat4 viewProj = Multiply(proj, view);
@@ -161,36 +262,30 @@ void DrawEntityESP(const std::vector<EntityData>& entities,
     float midX = screenX + screenW * 0.5f;
     float midY = screenY + screenH;
 
-    for (auto& ent : entities) {
-        if (!ent.valid) continue;
-
-        // Distance check
-        float dx = static_cast<float>(ent.posX) - cfg.camPos.x;
-        float dy = static_cast<float>(ent.posY) - cfg.camPos.y;
-        float dz = static_cast<float>(ent.posZ) - cfg.camPos.z;
-        float dist = sqrtf(dx*dx + dy*dy + dz*dz);
-        if (dist > cfg.maxDrawDist) continue;
+    for (uint32_t i : visible) {
+        float dist = sqrtf(dist2[i]);
 
         // ── Determine the 3D bounding box corners ────────────────────
         // If we have bounding box data, use it; otherwise approximate
         float minX, minY, minZ, maxX, maxY, maxZ;
 
-        bool hasBB = (ent.bbMaxX != ent.bbMinX) ||
-                     (ent.bbMaxY != ent.bbMinY) ||
-                     (ent.bbMaxZ != ent.bbMinZ);
+        const bool hasBB = (entities.flags[i] & entity_flag::HasBox) &&
+                           ((entities.bbMaxX[i] != entities.bbMinX[i]) ||
+                            (entities.bbMaxY[i] != entities.bbMinY[i]) ||
+                            (entities.bbMaxZ[i] != entities.bbMinZ[i]));
         if (hasBB) {
-            minX = static_cast<float>(ent.bbMinX);
-            minY = static_cast<float>(ent.bbMinY);
-            minZ = static_cast<float>(ent.bbMinZ);
-            maxX = static_cast<float>(ent.bbMaxX);
-            maxY = static_cast<float>(ent.bbMaxY);
-            maxZ = static_cast<float>(ent.bbMaxZ);
+            minX = rel.minX[i];
+            minY = rel.minY[i];
+            minZ = rel.minZ[i];
+            maxX = rel.maxX[i];
+            maxY = rel.maxY[i];
+            maxZ = rel.maxZ[i];
         } else {
             // Default: 0.6 x 1.8 x 0.6 entity hitbox centered at pos
             float hw = 0.3f, hh = 0.9f;
-            float px = static_cast<float>(ent.posX);
-            float py = static_cast<float>(ent.posY);
-            float pz = static_cast<float>(ent.posZ);
+            float px = rel.x[i];
+            float py = rel.y[i];
+            float pz = rel.z[i];
             minX = px - hw; maxX = px + hw;
             minY = py;      maxY = py + hh * 2.0f;
             minZ = pz - hw; maxZ = pz + hw;
@@ -260,9 +355,9 @@ void DrawEntityESP(const std::vector<EntityData>& entities,
             char label[64] = {};
             if (cfg.showLabels && cfg.showDistance)
                 snprintf(label, sizeof(label), "#%d [%.0fm]",
-                         ent.index, dist);
+                         rel.id[i], dist);
             else if (cfg.showLabels)
-                snprintf(label, sizeof(label), "#%d", ent.index);
+                snprintf(label, sizeof(label), "#%d", rel.id[i]);
             else
                 snprintf(label, sizeof(label), "%.0fm", dist);
 
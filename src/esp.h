@@ -2,6 +2,7 @@
 
 #include "entity.h"
 
+#include <chrono>
 #include <cstdint>
 #include <cmath>
 #include <vector>
@@ -44,6 +45,50 @@ struct EspConfig {
 
     // Culling
     float maxDrawDist = 256.0f;        // don't draw beyond this
+
+    // Motion smoothing (EntityMotion): draw entities where they are at
+    // present - interpDelayMs, extrapolating at most maxExtrapMs past
+    // the newest sample.  0 delay = lowest latency, pure prediction.
+    bool  smoothMotion  = true;
+    float interpDelayMs = 0.0f;
+    float maxExtrapMs   = 100.0f;
+};
+
+// ── Render-time motion smoothing ─────────────────────────────────────
+// Entity reads arrive at the read rate (20 Hz by default) while frames
+// are drawn at the monitor's rate.  EntityMotion keeps the last few
+// timestamped positions of every entity (by stable id) and moves each
+// one to the render time: interpolated between the two samples around
+// it, or extrapolated from the newest two.  Entities that jumped
+// further than a teleport threshold between samples aren't smoothed.
+class EntityMotion {
+public:
+    static constexpr int kSamples = 3;
+
+    // Record the positions of a snapshot; snapshots already seen (same
+    // capture time) are ignored, so this can be called every frame.
+    void Update(const EntitySnapshot& snap);
+
+    // `in` (the table last passed to Update()) with every position and
+    // box moved to time `at`.
+    void Apply(const EntityTable& in, std::chrono::steady_clock::time_point at,
+               float maxExtrapMs, EntityTable& out) const;
+
+private:
+    struct Sample {
+        std::chrono::steady_clock::time_point t;
+        double x, y, z;
+    };
+    struct Track {
+        int32_t id = 0;
+        int     count = 0;              // valid samples, newest last
+        Sample  s[kSamples];
+    };
+
+    std::chrono::steady_clock::time_point lastCapture{};
+    std::vector<Track>    tracks;       // row order of the last table
+    std::vector<Track>    next;
+    std::vector<uint32_t> byId;         // rows of `tracks` sorted by id
 };
 
 // ── ESP drawing ──────────────────────────────────────────────────────
@@ -55,9 +100,12 @@ bool WorldToScreen(const Vec3& world, const Mat4& viewProj,
                    float& outX, float& outY);
 
 // Draw ESP boxes for all valid entities onto ImGui's background draw list.
+// Culling and projection run on a camera-relative float copy of the
+// table (EntityTableF), so world coordinates far from the origin don't
+// cost float precision.
 // `screenOrigin` is the top-left of the Minecraft window in screen coords.
 // `screenW`/`screenH` is the Minecraft window size.
-void DrawEntityESP(const std::vector<EntityData>& entities,
+void DrawEntityESP(const EntityTable& entities,
                    const EspConfig& cfg,
                    float screenX, float screenY,
                    float screenW, float screenH);
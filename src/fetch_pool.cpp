@@ -0,0 +1,107 @@
+#include "fetch_pool.h"
+
+#include <algorithm>
+
+FetchPool::~FetchPool()
+{
+    Stop();
+}
+
+void FetchPool::Start(MemorySource& source, int threads, size_t cachePages)
+{
+    Stop();
+
+    // More threads than cores only adds switching
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, kMaxThreads);
+    if (cores > 0) threads = std::min(threads, cores);
+    stopping = false;
+    for (int i = 1; i < threads; ++i) {
+        helpers.push_back(std::make_unique<Helper>(source, cachePages));
+        Helper& h = *helpers.back();
+        h.thread = std::thread(&FetchPool::HelperLoop, this, std::ref(h));
+    }
+}
+
+void FetchPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        stopping = true;
+    }
+    work.notify_all();
+    for (auto& h : helpers)
+        if (h->thread.joinable()) h->thread.join();
+    helpers.clear();
+}
+
+void FetchPool::NewGeneration()
+{
+    // Helpers are parked between batches; the mutex orders this after
+    // their last read and before their next one.
+    std::lock_guard<std::mutex> lk(mtx);
+    for (auto& h : helpers)
+        h->cache.NewGeneration();
+}
+
+CachedMemorySource::Stats FetchPool::GetCacheStats() const
+{
+    CachedMemorySource::Stats sum;
+    for (const auto& h : helpers) {
+        auto s = h->cache.GetStats();
+        sum.hits     += s.hits;
+        sum.misses   += s.misses;
+        sum.bypassed += s.bypassed;
+    }
+    return sum;
+}
+
+size_t FetchPool::Parts(size_t count) const
+{
+    size_t parts = count / kMinPerThread;
+    return std::min(parts, static_cast<size_t>(Threads()));
+}
+
+size_t FetchPool::Dispatch(ReadRequest* reqs, size_t count, size_t per,
+                           size_t helperCount)
+{
+    size_t at = 0;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (size_t i = 0; i < helperCount && at < count; ++i) {
+            Helper& h = *helpers[i];
+            h.reqs  = reqs + at;
+            h.count = std::min(per, count - at);
+            h.busy  = true;
+            at += h.count;
+            ++pending;
+        }
+    }
+    work.notify_all();
+    return at;
+}
+
+void FetchPool::Join()
+{
+    std::unique_lock<std::mutex> lk(mtx);
+    done.wait(lk, [this] { return pending == 0; });
+}
+
+void FetchPool::HelperLoop(Helper& h)
+{
+    std::unique_lock<std::mutex> lk(mtx);
+    for (;;) {
+        work.wait(lk, [&] { return stopping || h.busy; });
+        if (stopping) return;
+
+        ReadRequest* reqs  = h.reqs;
+        size_t       count = h.count;
+        lk.unlock();
+        h.cache.ReadBatch(reqs, count);
+        lk.lock();
+
+        h.busy = false;
+        if (--pending == 0)
+            done.notify_one();
+    }
+}
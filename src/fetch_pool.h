@@ -0,0 +1,98 @@
+#pragma once
+
+#include "memory_source.h"
+#include "read_cache.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ── Bounded parallel batch fetch ─────────────────────────────────────
+// Splits one large ReadBatch across a few helper threads.  Against a
+// live process every request is a kernel call (or a handful, per page)
+// and those calls run concurrently, so a level of 10k object reads
+// takes roughly 1/N of the time on N threads.
+//
+// The caller's thread always takes a share itself, through its own
+// source; each helper reads through its own CachedMemorySource over
+// the shared inner source (caches aren't thread-safe, the platform
+// sources are).  Small batches aren't split: below kMinPerThread
+// requests per thread the hand-off costs more than it saves.
+//
+// Helpers are started once and parked on a condition variable between
+// batches; dispatching a batch allocates nothing.
+class FetchPool {
+public:
+    static constexpr int    kMaxThreads   = 8;      // including the caller
+    static constexpr size_t kMinPerThread = 512;
+
+    FetchPool() = default;
+    ~FetchPool();
+
+    FetchPool(const FetchPool&) = delete;
+    FetchPool& operator=(const FetchPool&) = delete;
+
+    // Start `threads - 1` helpers (clamped to 1..kMaxThreads and the
+    // core count) reading through `source`, each with a cache of
+    // `cachePages` pages.
+    void Start(MemorySource& source, int threads, size_t cachePages = 1024);
+    void Stop();
+
+    // Threads a batch can be split across, the caller's included.
+    int Threads() const { return static_cast<int>(helpers.size()) + 1; }
+
+    // New page-cache generation for every helper (call once per tick,
+    // from the dispatching thread, between batches).
+    void NewGeneration();
+
+    // Combined page-cache counters of the helpers.  Any thread.
+    CachedMemorySource::Stats GetCacheStats() const;
+
+    // Perform `reqs[0..count)`: the caller reads the last share through
+    // `own`, the helpers the others.  Returns once all are done.
+    template <typename Source>
+    void ReadBatch(Source& own, ReadRequest* reqs, size_t count)
+    {
+        size_t parts = Parts(count);
+        if (parts <= 1) {
+            own.ReadBatch(reqs, count);
+            return;
+        }
+        size_t per  = (count + parts - 1) / parts;
+        size_t done = Dispatch(reqs, count, per, parts - 1);
+        own.ReadBatch(reqs + done, count - done);
+        Join();
+    }
+
+private:
+    struct Helper {
+        std::thread        thread;
+        CachedMemorySource cache;
+        ReadRequest*       reqs  = nullptr;     // current share, under mtx
+        size_t             count = 0;
+        bool               busy  = false;
+
+        explicit Helper(MemorySource& inner, size_t pages) : cache(inner, pages) {}
+    };
+
+    size_t Parts(size_t count) const;
+
+    // Hand consecutive shares of `per` requests to `helperCount`
+    // helpers; returns the number of requests handed out.
+    size_t Dispatch(ReadRequest* reqs, size_t count, size_t per, size_t helperCount);
+
+    // Wait for every dispatched share.
+    void Join();
+
+    void HelperLoop(Helper& h);
+
+    std::vector<std::unique_ptr<Helper>> helpers;
+    std::mutex              mtx;
+    std::condition_variable work;       // helpers: a share was posted / stop
+    std::condition_variable done;       // caller: a share finished
+    size_t                  pending  = 0;
+    bool                    stopping = false;
+};
@@ -1,13 +1,19 @@
 #include "overlay.h"
 #include "mc_process.h"
+#include "memory_source.h"
+#include "read_cache.h"
+#include "region_map.h"
+#include "snapshot_file.h"
 #include "scanner.h"
+#include "value_scan.h"
+#include "pointer_scan.h"
 #include "entity.h"
 #include "esp.h"
 
 #include <imgui.h>
+#include <algorithm>
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <cstdio>
 #include <thread>
 #include <chrono>
@@ -35,11 +41,25 @@ int main()
         return 1;
     }
 
+    // ── Memory source (all target reads go through it) ───────────────
+    // `mem` is the region map in front of the process: scans enumerate
+    // its cached regions and reads of unmapped addresses never reach
+    // ReadProcessMemory.
+    Win32MemorySource target(proc.handle);
+    RegionMap mem(target);
+    mem.StartAutoRefresh(1000);
+
+    // The UI thread reads through its own page cache (a cache isn't
+    // shared across threads); one generation per frame.
+    CachedMemorySource panelMem(mem, 64);
+
     // ── Entity reader ────────────────────────────────────────────────
     EntityReader entityReader;
 
     // ── ESP ──────────────────────────────────────────────────────────
     EspConfig espCfg;
+    EntityMotion espMotion;
+    EntityTable  espEntities;       // reader snapshot moved to render time
     bool f3WasDown = false;
 
     // ── State ────────────────────────────────────────────────────────
@@ -47,15 +67,39 @@ int main()
     char aobBuf[256]   = "48 8B 05 ?? ?? ?? ?? 48 85 C0";
     char chainBaseBuf[20] = "0x0";
     char chainOffBuf[128] = "0x10,0x48,0x20";
+    uintptr_t        chainBase = 0;     // last chain given to the reader
+    std::vector<int> chainOffsets;
     int  readSize       = 4;
     bool insertWasDown  = false;
     bool showModules    = false;
     bool showCmdLine    = false;
 
     // Scanner state
+    IncrementalScanner scanner;
     std::vector<ScanResult> scanResults;
     int selectedResult = 0;
 
+    // Value scanner state
+    ValueScanner valueScanner;
+    std::vector<ValueHit> valueHits;
+    int  valueType    = 0;     // ValueType
+    int  valueCmp     = 0;     // ValueCompare
+    char valueBufA[32] = "100";
+    char valueBufB[32] = "200";
+
+    // Pointer scan state (map build + search run on the job's thread)
+    PointerScanJob     ptrJob;
+    PointerScanResult  ptrResults;
+    PointerScanOptions ptrOpts;
+    char ptrTargetBuf[20]  = "0x0";
+    char ptrFileBuf[128]   = "pointers.wptr";
+
+    // Snapshot capture
+    char snapFileBuf[128]  = "capture.wsnap";
+
+    // Per-frame buffers, reused across frames
+    std::string pathLabel;
+
     snprintf(addrBuf, sizeof(addrBuf), "0x%llX",
              static_cast<unsigned long long>(proc.base));
 
@@ -88,15 +132,29 @@ int main()
 
         // ── Render ───────────────────────────────────────────────────
         overlay.BeginFrame();
+        panelMem.NewGeneration();
+
+        // Reader output for this frame: no lock, no copy
+        const EntitySnapshot& snap = entityReader.AcquireSnapshot();
+        const auto& ents = snap.entities;
 
         // ── ESP: draw boxes on the background draw list ──────────────
         {
-            auto ents = entityReader.GetEntities();
+            espMotion.Update(snap);
+            const EntityTable* espSource = &ents;
+            if (espCfg.smoothMotion) {
+                auto renderTime = std::chrono::steady_clock::now() -
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<float, std::milli>(espCfg.interpDelayMs));
+                espMotion.Apply(ents, renderTime, espCfg.maxExtrapMs, espEntities);
+                espSource = &espEntities;
+            }
+
             float tw = static_cast<float>(targetRect.right  - targetRect.left);
             float th = static_cast<float>(targetRect.bottom - targetRect.top);
             // Overlay is positioned at targetRect, so ESP coords are
             // relative to (0,0) of the overlay = targetRect origin.
-            DrawEntityESP(ents, espCfg, 0, 0, tw, th);
+            DrawEntityESP(*espSource, espCfg, 0, 0, tw, th);
         }
 
         ImGui::SetNextWindowBgAlpha(0.90f);
@@ -116,8 +174,16 @@ int main()
 
             if (ImGui::Button("Re-detect")) {
                 entityReader.Stop();
+                ptrJob.Reset();
+                mem.StopAutoRefresh();
                 if (proc.handle) CloseHandle(proc.handle);
                 proc = FindMinecraft();
+                target.Attach(proc.handle);
+                mem.StartAutoRefresh(1000);
+                panelMem.NewGeneration();
+                scanner.Reset();
+                valueScanner.Reset();
+                valueHits.clear();
                 scanResults.clear();
                 if (proc.pid)
                     snprintf(addrBuf, sizeof(addrBuf), "0x%llX",
@@ -131,18 +197,18 @@ int main()
             if (showModules && !proc.mcModules.empty()) {
                 for (auto& mod : proc.mcModules) {
                     auto pos = mod.find_last_of(L'\\');
-                    std::wstring name = (pos != std::wstring::npos)
-                        ? mod.substr(pos + 1) : mod;
-                    ImGui::BulletText("%ls", name.c_str());
+                    const wchar_t* name = (pos != std::wstring::npos)
+                        ? mod.c_str() + pos + 1 : mod.c_str();
+                    ImGui::BulletText("%ls", name);
                 }
             }
             if (showCmdLine && !proc.cmdLine.empty()) {
-                std::string narrow;
-                narrow.resize(proc.cmdLine.size());
-                for (size_t ci = 0; ci < proc.cmdLine.size(); ++ci)
+                char narrow[513];
+                size_t len = std::min<size_t>(proc.cmdLine.size(), 512);
+                for (size_t ci = 0; ci < len; ++ci)
                     narrow[ci] = static_cast<char>(proc.cmdLine[ci] & 0x7F);
-                if (narrow.size() > 512) narrow.resize(512);
-                ImGui::TextWrapped("%s...", narrow.c_str());
+                narrow[len] = '\0';
+                ImGui::TextWrapped("%s...", narrow);
             }
 
             ImGui::Separator();
@@ -156,8 +222,7 @@ int main()
                         "JVM Entity Reader");
                     ImGui::Separator();
 
-                    std::string readerStatus = entityReader.GetStatus();
-                    ImGui::Text("Status: %s", readerStatus.c_str());
+                    ImGui::Text("Status: %s", snap.status.c_str());
 
                     // ── JVM Oop config ───────────────────────────────
                     if (ImGui::TreeNode("JVM Compressed Oops")) {
@@ -168,6 +233,20 @@ int main()
                         ImGui::InputText("Heap Base", hbBuf, sizeof(hbBuf));
                         entityReader.oops.heapBase =
                             std::strtoull(hbBuf, nullptr, 16);
+                        ImGui::InputInt("Klass Offset", &entityReader.oops.klassOffset);
+                        ImGui::Checkbox("Compressed Klass", &entityReader.oops.compressedKlass);
+                        // Klass check: pin the klasses of a table known
+                        // to be right; rows of any other klass are rejected
+                        if (ImGui::Button("Pin Klasses"))
+                            entityReader.PinKlasses();
+                        ImGui::SameLine();
+                        if (ImGui::Button("Forget Klasses"))
+                            entityReader.ForgetKlasses();
+                        if (snap.entityKlasses > 0 || snap.boxKlasses > 0)
+                            ImGui::Text("Expecting %d Entity / %d Box klasses",
+                                        snap.entityKlasses, snap.boxKlasses);
+                        else
+                            ImGui::TextDisabled("Klasses not checked");
                         ImGui::TreePop();
                     }
 
@@ -180,23 +259,128 @@ int main()
                                          chainOffBuf, sizeof(chainOffBuf));
                         ImGui::TextWrapped(
                             "Format: base -> [+off0] -> [+off1] -> entity list. "
-                            "Discover with Cheat Engine pointer scan.");
+                            "Discover with the pointer scan below.");
 
-                        // Parse into offsets struct
-                        entityReader.offsets.chainBase =
-                            std::strtoull(chainBaseBuf, nullptr, 16);
+                        // Parsed in place every frame; handed to the reader
+                        // (which allocates) only when the chain changes.
                         {
-                            entityReader.offsets.chainOffsets.clear();
-                            std::string s(chainOffBuf);
-                            std::istringstream ss(s);
-                            std::string tok;
-                            while (std::getline(ss, tok, ',')) {
-                                if (tok.empty()) continue;
-                                entityReader.offsets.chainOffsets.push_back(
-                                    static_cast<int>(
-                                        std::strtol(tok.c_str(), nullptr, 16)));
+                            uintptr_t base = std::strtoull(chainBaseBuf, nullptr, 16);
+                            int parsed[32];
+                            size_t n = 0;
+                            for (const char* p = chainOffBuf; *p && n < 32; ) {
+                                char* end = nullptr;
+                                long v = std::strtol(p, &end, 16);
+                                if (end != p) parsed[n++] = static_cast<int>(v);
+                                p = (*end == ',') ? end + 1 : (end != p ? end : p + 1);
+                            }
+                            if (base != chainBase ||
+                                !std::equal(chainOffsets.begin(), chainOffsets.end(),
+                                            parsed, parsed + n)) {
+                                chainBase = base;
+                                chainOffsets.assign(parsed, parsed + n);
+                                entityReader.SetChain(chainBase, chainOffsets);
                             }
                         }
+
+                        // ── Pointer scan ─────────────────────────────
+                        if (ImGui::TreeNode("Pointer Scan")) {
+                            ImGui::InputText("Target", ptrTargetBuf,
+                                             sizeof(ptrTargetBuf));
+                            ImGui::SliderInt("Max depth", &ptrOpts.maxDepth, 1, 7);
+                            ImGui::InputInt("Max offset", &ptrOpts.maxOffset, 8, 0x100,
+                                            ImGuiInputTextFlags_CharsHexadecimal);
+                            ptrOpts.maxDepth  = std::clamp(ptrOpts.maxDepth, 1, 7);
+                            ptrOpts.maxOffset = std::clamp(ptrOpts.maxOffset, 0, 0x100000);
+
+                            if (ptrJob.Running()) {
+                                const auto& p = ptrJob.Progress();
+                                if (p.depth == 0)
+                                    ImGui::Text("Building pointer map...");
+                                else
+                                    ImGui::Text("Depth %d, %zu links, %zu bases",
+                                                p.depth.load(), p.links.load(),
+                                                p.paths.load());
+                                if (ImGui::Button("Cancel##ptr")) ptrJob.Cancel();
+                            } else if (ImGui::Button("Scan##ptr") && proc.handle) {
+                                uintptr_t ptrTarget =
+                                    std::strtoull(ptrTargetBuf, nullptr, 16);
+                                ptrJob.Start(mem, ptrTarget, ptrOpts);
+                            }
+
+                            if (ptrJob.TakeResult(ptrResults)) {
+                                const auto& p = ptrJob.Progress();
+                                std::cout << "[ptrscan] Map: " << ptrJob.Map().Size()
+                                          << " pointers (" << ptrJob.Map().BuildMs()
+                                          << " ms), " << ptrResults.paths.size()
+                                          << " paths, " << p.links.load() << " links"
+                                          << (p.truncated ? " (stopped early)" : "")
+                                          << "\n";
+                            }
+
+                            ImGui::InputText("File", ptrFileBuf, sizeof(ptrFileBuf));
+                            if (ImGui::Button("Save##ptr")) {
+                                bool ok = SavePointerPaths(ptrFileBuf, ptrResults);
+                                std::cout << "[ptrscan] Save " << ptrFileBuf
+                                          << (ok ? " OK\n" : " FAILED\n");
+                            }
+                            ImGui::SameLine();
+                            if (ImGui::Button("Load##ptr")) {
+                                if (!LoadPointerPaths(ptrFileBuf, ptrResults))
+                                    std::cout << "[ptrscan] Load " << ptrFileBuf
+                                              << " FAILED\n";
+                            }
+                            ImGui::SameLine();
+                            if (ImGui::Button("Intersect with file")) {
+                                PointerScanResult other;
+                                if (LoadPointerPaths(ptrFileBuf, other)) {
+                                    ptrResults = IntersectPointerPaths(ptrResults, other);
+                                    std::cout << "[ptrscan] " << ptrResults.paths.size()
+                                              << " paths after intersect\n";
+                                } else {
+                                    std::cout << "[ptrscan] Load " << ptrFileBuf
+                                              << " FAILED\n";
+                                }
+                            }
+                            ImGui::SameLine();
+                            if (ImGui::Button("Rescan##ptr") && proc.handle) {
+                                // Keep the paths that still reach the target
+                                uintptr_t ptrTarget =
+                                    std::strtoull(ptrTargetBuf, nullptr, 16);
+                                size_t kept = FilterPointerPaths(
+                                    mem, ptrResults, ptrTarget, mem.Modules());
+                                std::cout << "[ptrscan] " << kept
+                                          << " paths still reach 0x" << std::hex
+                                          << ptrTarget << std::dec << "\n";
+                            }
+
+                            ImGui::Text("Paths: %zu", ptrResults.paths.size());
+                            size_t show = std::min<size_t>(ptrResults.paths.size(), 32);
+                            for (size_t i = 0; i < show; ++i) {
+                                const auto& path = ptrResults.paths[i];
+                                FormatPointerPath(ptrResults, path, pathLabel);
+                                if (!ImGui::Selectable(pathLabel.c_str())) continue;
+
+                                // Use it: resolve the module base in this session
+                                auto live = ptrJob.Map().Modules().empty()
+                                    ? mem.Modules() : ptrJob.Map().Modules();
+                                uintptr_t base = ResolvePathBase(ptrResults, path, live);
+                                snprintf(chainBaseBuf, sizeof(chainBaseBuf), "0x%llX",
+                                         static_cast<unsigned long long>(base));
+                                std::string offs;
+                                for (int off : path.offsets) {
+                                    char tok[16];
+                                    snprintf(tok, sizeof(tok), "%s0x%X",
+                                             offs.empty() ? "" : ",", off);
+                                    offs += tok;
+                                }
+                                snprintf(chainOffBuf, sizeof(chainOffBuf), "%s",
+                                         offs.c_str());
+                            }
+                            if (ptrResults.paths.size() > show)
+                                ImGui::Text("... +%zu more",
+                                            ptrResults.paths.size() - show);
+                            ImGui::TreePop();
+                        }
                         ImGui::TreePop();
                     }
 
@@ -219,6 +403,11 @@ int main()
                         ImGui::InputInt("BB maxY off", &o.bbMaxYOffset);
                         ImGui::InputInt("BB maxZ off", &o.bbMaxZOffset);
                         ImGui::InputInt("Max entities", &o.maxEntities);
+                        ImGui::Separator();
+                        ObjectSpan es = o.EntitySpan(entityReader.oops);
+                        ObjectSpan bs = o.BoxSpan(entityReader.oops);
+                        ImGui::Text("Entity read: +0x%X, %d bytes", es.begin, es.size);
+                        ImGui::Text("Box read:    +0x%X, %d bytes", bs.begin, bs.size);
                         ImGui::TreePop();
                     }
 
@@ -227,7 +416,7 @@ int main()
                     // ── Controls ─────────────────────────────────────
                     if (!entityReader.IsRunning()) {
                         if (ImGui::Button("Start Reader") && proc.handle) {
-                            entityReader.Start(proc.handle);
+                            entityReader.Start(mem);
                         }
                     } else {
                         if (ImGui::Button("Stop Reader")) {
@@ -237,17 +426,57 @@ int main()
 
                     if (entityReader.IsRunning()) {
                         ImGui::SameLine();
-                        bool enabled = entityReader.entityReadEnabled.load();
+                        bool enabled = entityReader.ReadEnabled();
                         if (ImGui::Checkbox("Read Entities", &enabled))
-                            entityReader.entityReadEnabled.store(enabled);
+                            entityReader.SetReadEnabled(enabled);
 
                         ImGui::SameLine();
                         if (ImGui::Button("Scan Strings"))
                             entityReader.RequestStringScan();
                     }
 
-                    ImGui::SliderInt("Interval (ms)",
-                                     &entityReader.readIntervalMs, 10, 500);
+                    static const char* scheduleNames[] = {
+                        "Fixed rate", "Max rate (CPU budget)", "Every frame" };
+                    int mode = static_cast<int>(entityReader.schedule);
+                    if (ImGui::Combo("Schedule", &mode, scheduleNames, 3))
+                        entityReader.schedule = static_cast<ScheduleMode>(mode);
+                    if (entityReader.schedule == ScheduleMode::FixedRate)
+                        ImGui::SliderInt("Interval (ms)",
+                                         &entityReader.readIntervalMs, 1, 500);
+                    else if (entityReader.schedule == ScheduleMode::MaxRate)
+                        ImGui::SliderFloat("CPU budget",
+                                           &entityReader.cpuBudget, 0.01f, 1.0f, "%.2f");
+                    ImGui::SliderInt("Fetch threads (on start)",
+                                     &entityReader.fetchThreads, 1, FetchPool::kMaxThreads);
+
+                    if (entityReader.IsRunning()) {
+                        auto cs = entityReader.GetCacheStats();
+                        uint64_t lookups = cs.hits + cs.misses;
+                        ImGui::Text("Page cache: %llu hits / %llu misses (%.1f%%)",
+                            static_cast<unsigned long long>(cs.hits),
+                            static_cast<unsigned long long>(cs.misses),
+                            lookups ? 100.0 * cs.hits / lookups : 0.0);
+
+                        auto ss = entityReader.GetScheduleStats();
+                        ImGui::Text("Rate %.1f Hz  period %.2f ms  jitter %.3f ms  busy %.0f%%  late %llu",
+                            ss.rateHz, ss.periodMs, ss.jitterMs, ss.busy * 100.0,
+                            static_cast<unsigned long long>(ss.overruns));
+
+                        const auto& tm = snap.timings;
+                        ImGui::Text("Tick %.0f us: chain %.0f (%d reads) | slice %.0f | %d entities %.0f | %d boxes %.0f (%d reused)",
+                            tm.totalUs, tm.chainUs, tm.chainReads, tm.sliceUs,
+                            tm.entities, tm.entitiesUs, tm.boxes, tm.boxesUs, tm.boxesReused);
+
+                        const auto& d = snap.delta;
+                        ImGui::Text("Delta: +%zu entered  -%zu left  %zu moved  %d re-keyed",
+                            d.entered.size(), d.left.size(), d.moved.size(), d.rekeyed);
+
+                        ImGui::Text("Header check: %d rejected%s",
+                            tm.rejected, tm.relocated ? "  (GC relocation, chain re-walked)" : "");
+
+                        ImGui::Text("Fetch threads %d  arena %.1f KB",
+                            entityReader.FetchThreads(), entityReader.ArenaBytes() / 1024.0);
+                    }
 
                     // ── ESP config ────────────────────────────────────
                     ImGui::Separator();
@@ -266,6 +495,13 @@ int main()
                         &espCfg.thickness, 1.0f, 5.0f);
                     ImGui::SliderFloat("Max Dist",
                         &espCfg.maxDrawDist, 16.0f, 512.0f);
+                    ImGui::Checkbox("Smooth Motion", &espCfg.smoothMotion);
+                    if (espCfg.smoothMotion) {
+                        ImGui::SliderFloat("Render Delay (ms)",
+                            &espCfg.interpDelayMs, 0.0f, 100.0f, "%.0f");
+                        ImGui::SliderFloat("Max Extrapolation (ms)",
+                            &espCfg.maxExtrapMs, 0.0f, 250.0f, "%.0f");
+                    }
 
                     if (ImGui::TreeNode("Camera (Identity Placeholder)")) {
                         ImGui::DragFloat3("Position",
@@ -286,52 +522,62 @@ int main()
 
                     // ── String scan results ──────────────────────────
                     auto finds = entityReader.GetStringFinds();
-                    if (!finds.empty()) {
+                    if (finds && !finds->empty()) {
                         ImGui::Separator();
                         ImGui::TextColored({0.4f,1.0f,0.4f,1},
-                            "Class Strings Found: %zu", finds.size());
+                            "Class Strings Found: %zu", finds->size());
 
-                        int showN = (static_cast<int>(finds.size()) < 32)
-                            ? static_cast<int>(finds.size()) : 32;
+                        int showN = (static_cast<int>(finds->size()) < 32)
+                            ? static_cast<int>(finds->size()) : 32;
                         for (int i = 0; i < showN; ++i) {
                             ImGui::Text("  0x%llX  %s",
                                 static_cast<unsigned long long>(
-                                    finds[i].address),
-                                finds[i].text.c_str());
+                                    (*finds)[i].address),
+                                (*finds)[i].text.c_str());
                         }
-                        if (finds.size() > 32)
+                        if (finds->size() > 32)
                             ImGui::Text("  ... +%zu more",
-                                        finds.size() - 32);
+                                        finds->size() - 32);
                     }
 
                     // ── Entity data ──────────────────────────────────
-                    auto ents = entityReader.GetEntities();
-                    if (!ents.empty()) {
+                    // (`ents` was already fetched this frame for the ESP)
+                    if (ents.Size() > 0) {
                         ImGui::Separator();
                         ImGui::TextColored({0.4f,1.0f,0.4f,1},
-                            "Entities: %zu", ents.size());
+                            "Entities: %zu", ents.Size());
 
                         int validCount = 0;
-                        for (auto& e : ents)
-                            if (e.valid) ++validCount;
+                        for (uint8_t f : ents.flags)
+                            if (f & entity_flag::Valid) ++validCount;
 
                         ImGui::Text("Valid: %d / %zu",
-                                    validCount, ents.size());
+                                    validCount, ents.Size());
 
                         if (ImGui::BeginChild("EntityList",
                                 {0, 200}, true))
                         {
-                            for (auto& e : ents) {
-                                if (!e.valid) continue;
-                                ImGui::Text("#%-3d X:%.2f Y:%.2f Z:%.2f",
-                                    e.index, e.posX, e.posY, e.posZ);
-                                if (ImGui::IsItemHovered() &&
-                                    (e.bbMaxX != 0 || e.bbMaxY != 0))
-                                {
-                                    ImGui::SetTooltip(
-                                        "BB: [%.1f,%.1f,%.1f]-[%.1f,%.1f,%.1f]",
-                                        e.bbMinX, e.bbMinY, e.bbMinZ,
-                                        e.bbMaxX, e.bbMaxY, e.bbMaxZ);
+                            // Thousands of rows: only lay out the visible ones
+                            ImGuiListClipper clipper;
+                            clipper.Begin(static_cast<int>(ents.Size()));
+                            while (clipper.Step()) {
+                                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                                    if (!ents.Valid(i)) {
+                                        ImGui::TextDisabled("#%-3d (%s)", ents.id[i],
+                                            (ents.flags[i] & entity_flag::Rejected)
+                                                ? "rejected" : "invalid");
+                                        continue;
+                                    }
+                                    ImGui::Text("#%-3d X:%.2f Y:%.2f Z:%.2f",
+                                        ents.id[i], ents.posX[i], ents.posY[i], ents.posZ[i]);
+                                    if (ImGui::IsItemHovered() &&
+                                        (ents.flags[i] & entity_flag::HasBox))
+                                    {
+                                        ImGui::SetTooltip(
+                                            "BB: [%.1f,%.1f,%.1f]-[%.1f,%.1f,%.1f]",
+                                            ents.bbMinX[i], ents.bbMinY[i], ents.bbMinZ[i],
+                                            ents.bbMaxX[i], ents.bbMaxY[i], ents.bbMaxZ[i]);
+                                    }
                                 }
                             }
                         }
@@ -352,17 +598,52 @@ int main()
                     if (ImGui::Button("Scan") && proc.handle) {
                         std::cout << "[scanner] Scanning: " << aobBuf << "\n";
                         auto pat = ParsePattern(aobBuf);
-                        scanResults = PatternScan(proc.handle, pat);
+                        if (pat.bytes.empty())
+                            std::cout << "[scanner] Invalid pattern\n";
+                        scanResults = scanner.Scan(mem, pat);
                         selectedResult = 0;
+
+                        const auto& st = scanner.LastStats();
                         std::cout << "[scanner] " << scanResults.size()
-                                  << " results\n";
+                                  << " results (" << st.pagesScanned << "/"
+                                  << st.pagesTotal << " pages scanned, "
+                                  << st.ms << " ms)\n";
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Find First") && proc.handle) {
+                        // Two hits are enough to tell unique from ambiguous
+                        auto pat = ParsePattern(aobBuf);
+                        auto t0 = std::chrono::steady_clock::now();
+                        scanResults = PatternScanFirst(mem, pat, 2);
+                        selectedResult = 0;
+                        double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+
+                        std::cout << "[scanner] First match: "
+                                  << (scanResults.empty() ? "none" :
+                                      scanResults.size() == 1 ? "unique" : "not unique")
+                                  << " (" << ms << " ms)\n";
+                        if (!scanResults.empty())
+                            snprintf(addrBuf, sizeof(addrBuf), "0x%llX",
+                                     static_cast<unsigned long long>(
+                                         scanResults[0].address));
                     }
                     ImGui::SameLine();
                     if (ImGui::Button("Clear")) {
+                        scanner.Reset();
                         scanResults.clear();
                         selectedResult = 0;
                     }
 
+                    {
+                        const auto& st = scanner.LastStats();
+                        if (st.pagesTotal > 0)
+                            ImGui::TextColored({0.5f,0.5f,0.5f,1},
+                                "%s: %zu/%zu pages scanned in %.0f ms",
+                                st.fullScan ? "Full scan" : "Rescan",
+                                st.pagesScanned, st.pagesTotal, st.ms);
+                    }
+
                     if (!scanResults.empty()) {
                         ImGui::Text("Results: %zu", scanResults.size());
 
@@ -394,6 +675,102 @@ int main()
                     ImGui::EndTabItem();
                 }
 
+                // ============ TAB: Value Scanner =====================
+                if (ImGui::BeginTabItem("Values")) {
+                    ImGui::TextColored({0.4f,0.8f,1.0f,1},
+                        "Value Scanner");
+                    ImGui::Separator();
+
+                    static const char* typeNames[] =
+                        { "int32", "int64", "float", "double" };
+                    static const char* cmpNames[] =
+                        { "Exact", "Range", "Unknown", "Changed",
+                          "Unchanged", "Increased", "Decreased" };
+
+                    bool first = !valueScanner.HasScan();
+                    if (!first) ImGui::BeginDisabled();
+                    ImGui::Combo("Type", &valueType, typeNames, 4);
+                    if (!first) ImGui::EndDisabled();
+                    ImGui::Combo("Compare", &valueCmp, cmpNames, 7);
+
+                    auto cmp = static_cast<ValueCompare>(valueCmp);
+                    auto vt  = static_cast<ValueType>(valueType);
+                    bool needsA = cmp == ValueCompare::Exact ||
+                                  cmp == ValueCompare::Range;
+                    if (needsA)
+                        ImGui::InputText("Value", valueBufA, sizeof(valueBufA));
+                    if (cmp == ValueCompare::Range)
+                        ImGui::InputText("Max", valueBufB, sizeof(valueBufB));
+
+                    ScanValue va, vb;
+                    bool valid = (!needsA || ParseScanValue(vt, valueBufA, va)) &&
+                                 (cmp != ValueCompare::Range ||
+                                  ParseScanValue(vt, valueBufB, vb));
+
+                    if (ImGui::Button("First Scan") && proc.handle) {
+                        if (!valid || cmp > ValueCompare::Unknown) {
+                            std::cout << "[values] First scan needs Exact, "
+                                         "Range or Unknown with a valid value\n";
+                        } else {
+                            valueScanner.FirstScan(mem, vt, cmp, va, vb);
+                            valueScanner.Peek(64, valueHits);
+                            std::cout << "[values] First scan ("
+                                      << ValueTypeName(vt) << "): "
+                                      << valueScanner.Count() << " candidates ("
+                                      << valueScanner.LastMs() << " ms)\n";
+                        }
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Next Scan") && proc.handle &&
+                        valueScanner.HasScan())
+                    {
+                        if (!valid || cmp == ValueCompare::Unknown) {
+                            std::cout << "[values] Invalid next-scan compare\n";
+                        } else {
+                            valueScanner.NextScan(mem, cmp, va, vb);
+                            valueScanner.Peek(64, valueHits);
+                            std::cout << "[values] Next scan: "
+                                      << valueScanner.Count() << " candidates ("
+                                      << valueScanner.LastMs() << " ms)\n";
+                        }
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Reset##values")) {
+                        valueScanner.Reset();
+                        valueHits.clear();
+                    }
+
+                    if (valueScanner.HasScan()) {
+                        ImGui::Text("Candidates: %zu  (%.0f ms)",
+                            valueScanner.Count(), valueScanner.LastMs());
+
+                        bool isFloat = valueScanner.Type() == ValueType::Float ||
+                                       valueScanner.Type() == ValueType::Double;
+                        for (const auto& h : valueHits) {
+                            char label[96];
+                            if (isFloat)
+                                snprintf(label, sizeof(label), "0x%llX  =  %g",
+                                    static_cast<unsigned long long>(h.address),
+                                    h.value.f);
+                            else
+                                snprintf(label, sizeof(label), "0x%llX  =  %lld",
+                                    static_cast<unsigned long long>(h.address),
+                                    static_cast<long long>(h.value.i));
+                            if (ImGui::Selectable(label))
+                                snprintf(addrBuf, sizeof(addrBuf), "0x%llX",
+                                    static_cast<unsigned long long>(h.address));
+                        }
+                        if (valueScanner.Count() > valueHits.size())
+                            ImGui::Text("... +%zu more",
+                                        valueScanner.Count() - valueHits.size());
+                    } else {
+                        ImGui::TextColored({0.5f,0.5f,0.5f,1},
+                            "No scan yet");
+                    }
+
+                    ImGui::EndTabItem();
+                }
+
                 // ============ TAB: Memory Reader ======================
                 if (ImGui::BeginTabItem("Memory")) {
                     ImGui::TextColored({0.4f,0.8f,1.0f,1},
@@ -413,8 +790,8 @@ int main()
 
                         switch (readSize) {
                         case 1:
-                            if (auto v = ReadMemory<uint8_t>(
-                                    proc.handle, memAddr))
+                            if (auto v = ReadValue<uint8_t>(
+                                    panelMem, memAddr))
                                 ImGui::Text("  uint8  = %u (0x%02X)",
                                             *v, *v);
                             else
@@ -422,8 +799,8 @@ int main()
                                     "  read failed");
                             break;
                         case 2:
-                            if (auto v = ReadMemory<uint16_t>(
-                                    proc.handle, memAddr))
+                            if (auto v = ReadValue<uint16_t>(
+                                    panelMem, memAddr))
                                 ImGui::Text("  uint16 = %u (0x%04X)",
                                             *v, *v);
                             else
@@ -431,28 +808,28 @@ int main()
                                     "  read failed");
                             break;
                         case 4:
-                            if (auto v = ReadMemory<int32_t>(
-                                    proc.handle, memAddr))
+                            if (auto v = ReadValue<int32_t>(
+                                    panelMem, memAddr))
                                 ImGui::Text("  int32  = %d (0x%08X)",
                                             *v, *v);
                             else
                                 ImGui::TextColored({1,0,0,1},
                                     "  read failed");
-                            if (auto v = ReadMemory<float>(
-                                    proc.handle, memAddr))
+                            if (auto v = ReadValue<float>(
+                                    panelMem, memAddr))
                                 ImGui::Text("  float  = %.4f", *v);
                             break;
                         case 8:
-                            if (auto v = ReadMemory<int64_t>(
-                                    proc.handle, memAddr))
+                            if (auto v = ReadValue<int64_t>(
+                                    panelMem, memAddr))
                                 ImGui::Text(
                                     "  int64  = %lld (0x%llX)", *v,
                                     static_cast<unsigned long long>(*v));
                             else
                                 ImGui::TextColored({1,0,0,1},
                                     "  read failed");
-                            if (auto v = ReadMemory<double>(
-                                    proc.handle, memAddr))
+                            if (auto v = ReadValue<double>(
+                                    panelMem, memAddr))
                                 ImGui::Text("  double = %.6f", *v);
                             break;
                         default:
@@ -460,30 +837,57 @@ int main()
                         }
 
                         // Hex dump
-                        auto bytes = ReadBytes(proc.handle, memAddr, 32);
-                        if (!bytes.empty()) {
+                        uint8_t bytes[32];
+                        size_t  byteCount =
+                            panelMem.Read(memAddr, bytes, sizeof(bytes));
+                        if (byteCount) {
                             ImGui::Separator();
                             ImGui::Text("Hex dump (+32 bytes):");
-                            std::string hexLine, asciiLine;
-                            for (size_t i = 0; i < bytes.size(); ++i) {
-                                char hex[4];
-                                snprintf(hex, sizeof(hex), "%02X ",
+                            char hexLine[16 * 3 + 1], asciiLine[16 + 1];
+                            size_t col = 0;
+                            for (size_t i = 0; i < byteCount; ++i) {
+                                snprintf(hexLine + col * 3, 4, "%02X ",
                                          bytes[i]);
-                                hexLine += hex;
-                                asciiLine +=
+                                asciiLine[col] =
                                     (bytes[i] >= 0x20 && bytes[i] < 0x7F)
                                     ? static_cast<char>(bytes[i]) : '.';
-                                if ((i + 1) % 16 == 0 ||
-                                    i + 1 == bytes.size())
+                                asciiLine[++col] = '\0';
+                                if (col == 16 || i + 1 == byteCount)
                                 {
                                     ImGui::Text("  %s |%s|",
-                                        hexLine.c_str(),
-                                        asciiLine.c_str());
-                                    hexLine.clear();
-                                    asciiLine.clear();
+                                        hexLine, asciiLine);
+                                    col = 0;
                                 }
                             }
                         }
+
+                        auto cs = panelMem.GetStats();
+                        auto rs = mem.GetStats();
+                        ImGui::Separator();
+                        ImGui::TextColored({0.5f,0.5f,0.5f,1},
+                            "Page cache: %llu hits / %llu misses",
+                            static_cast<unsigned long long>(cs.hits),
+                            static_cast<unsigned long long>(cs.misses));
+                        ImGui::TextColored({0.5f,0.5f,0.5f,1},
+                            "Region map: %zu regions (v%llu, %.1f ms), "
+                            "%llu unmapped reads skipped",
+                            rs.regions,
+                            static_cast<unsigned long long>(rs.version),
+                            rs.refreshMs,
+                            static_cast<unsigned long long>(rs.rejected));
+                        ImGui::SameLine();
+                        if (ImGui::SmallButton("Refresh"))
+                            mem.Refresh();
+                    }
+
+                    // ── Snapshot capture ─────────────────────────────
+                    ImGui::Separator();
+                    ImGui::InputText("Snapshot", snapFileBuf, sizeof(snapFileBuf));
+                    ImGui::SameLine();
+                    if (ImGui::Button("Capture") && proc.handle) {
+                        if (!SaveSnapshotFile(mem, snapFileBuf))
+                            std::cout << "[snapshot] Capture to " << snapFileBuf
+                                      << " FAILED\n";
                     }
 
                     ImGui::EndTabItem();
@@ -502,10 +906,12 @@ int main()
         ImGui::End();
 
         overlay.EndFrame();
+        entityReader.NotifyFrame();
     }
 
     // ── Cleanup ──────────────────────────────────────────────────────
     entityReader.Stop();
+    mem.StopAutoRefresh();
     overlay.Shutdown();
     if (proc.handle) CloseHandle(proc.handle);
 
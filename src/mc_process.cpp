@@ -416,6 +416,14 @@ std::vector<uint8_t> ReadBytes(HANDLE process, uintptr_t address, size_t count)
     return buf;
 }
 
+size_t ReadBytes(HANDLE process, uintptr_t address, std::span<uint8_t> out)
+{
+    SIZE_T bytesRead = 0;
+    ReadProcessMemory(process, reinterpret_cast<LPCVOID>(address),
+                      out.data(), out.size(), &bytesRead);
+    return static_cast<size_t>(bytesRead);
+}
+
 HWND GetTargetWindow(const wchar_t* windowTitle)
 {
     return FindWindowW(nullptr, windowTitle);
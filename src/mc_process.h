@@ -2,6 +2,7 @@
 
 #include <Windows.h>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,10 @@ std::optional<T> ReadMemory(HANDLE process, uintptr_t address);
 // Read a block of raw bytes.
 std::vector<uint8_t> ReadBytes(HANDLE process, uintptr_t address, size_t count);
 
+// Read into caller-owned storage without allocating.  Returns the number
+// of bytes copied.
+size_t ReadBytes(HANDLE process, uintptr_t address, std::span<uint8_t> out);
+
 // Locate a top-level window by exact title.
 HWND GetTargetWindow(const wchar_t* windowTitle);
 
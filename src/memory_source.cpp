@@ -0,0 +1,392 @@
+#include "memory_source.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <Psapi.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#endif
+
+// ─────────────────────────────────────────────────────────────────────
+std::span<uint8_t> ScratchBuffer(size_t size)
+{
+    thread_local std::vector<uint8_t> buf;
+    if (buf.size() < size) buf.resize(size);
+    return { buf.data(), size };
+}
+
+// ─────────────────────────────────────────────────────────────────────
+size_t MemorySource::ReadBatch(ReadRequest* reqs, size_t count)
+{
+    size_t ok = 0;
+    for (size_t i = 0; i < count; ++i) {
+        reqs[i].ok = Read(reqs[i].address, reqs[i].dst, reqs[i].size) == reqs[i].size;
+        ok += reqs[i].ok;
+    }
+    return ok;
+}
+
+size_t ReadBatchCoalesced(MemorySource& src, ReadRequest* reqs, size_t count)
+{
+    // Reused per thread: no allocation once warmed up
+    thread_local std::vector<uint32_t> order;
+    thread_local std::vector<uint8_t>  scratch;
+
+    order.clear();
+    size_t ok = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (reqs[i].size == 0) { reqs[i].ok = true; ++ok; continue; }
+        order.push_back(static_cast<uint32_t>(i));
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return reqs[a].address < reqs[b].address;
+    });
+
+    size_t i = 0;
+    while (i < order.size()) {
+        // Grow a group while the next request starts close enough
+        uintptr_t lo = reqs[order[i]].address;
+        uintptr_t hi = lo + reqs[order[i]].size;
+        size_t j = i + 1;
+        for (; j < order.size(); ++j) {
+            const auto& r = reqs[order[j]];
+            uintptr_t end = std::max(hi, r.address + r.size);
+            if (r.address > hi + kCoalesceGap || end - lo > kCoalesceSpan) break;
+            hi = end;
+        }
+
+        if (j == i + 1) {
+            auto& r = reqs[order[i]];
+            r.ok = src.Read(r.address, r.dst, r.size) == r.size;
+            ok += r.ok;
+            i = j;
+            continue;
+        }
+
+        scratch.resize(static_cast<size_t>(hi - lo));
+        size_t got = src.Read(lo, scratch.data(), scratch.size());
+
+        for (; i < j; ++i) {
+            auto& r = reqs[order[i]];
+            size_t off = static_cast<size_t>(r.address - lo);
+            if (off + r.size <= got) {
+                std::memcpy(r.dst, scratch.data() + off, r.size);
+                r.ok = true;
+            } else {
+                r.ok = src.Read(r.address, r.dst, r.size) == r.size;
+            }
+            ok += r.ok;
+        }
+    }
+    return ok;
+}
+
+// =====================================================================
+//  Win32
+// =====================================================================
+#if defined(_WIN32)
+
+std::vector<MemoryRegion> Win32MemorySource::Regions()
+{
+    std::vector<MemoryRegion> regions;
+
+    SYSTEM_INFO si{};
+    GetSystemInfo(&si);
+
+    uintptr_t addr = reinterpret_cast<uintptr_t>(si.lpMinimumApplicationAddress);
+    uintptr_t end  = reinterpret_cast<uintptr_t>(si.lpMaximumApplicationAddress);
+
+    MEMORY_BASIC_INFORMATION mbi{};
+
+    while (addr < end) {
+        if (VirtualQueryEx(process, reinterpret_cast<LPCVOID>(addr),
+                           &mbi, sizeof(mbi)) == 0)
+            break;
+
+        // Only committed, readable regions
+        if (mbi.State == MEM_COMMIT &&
+            (mbi.Protect == PAGE_READWRITE      ||
+             mbi.Protect == PAGE_READONLY        ||
+             mbi.Protect == PAGE_EXECUTE_READ    ||
+             mbi.Protect == PAGE_EXECUTE_READWRITE ||
+             mbi.Protect == PAGE_WRITECOPY       ||
+             mbi.Protect == PAGE_EXECUTE_WRITECOPY))
+        {
+            MemoryRegion r;
+            r.base    = addr;
+            r.size    = static_cast<size_t>(mbi.RegionSize);
+            r.protect = static_cast<uint32_t>(mbi.Protect);
+            r.type    = static_cast<uint32_t>(mbi.Type);
+            regions.push_back(r);
+        }
+
+        addr += mbi.RegionSize;
+    }
+
+    return regions;
+}
+
+std::vector<ModuleInfo> Win32MemorySource::Modules()
+{
+    std::vector<ModuleInfo> modules;
+
+    HMODULE mods[2048];
+    DWORD cbNeeded = 0;
+    if (!EnumProcessModulesEx(process, mods, sizeof(mods), &cbNeeded,
+                              LIST_MODULES_ALL))
+        return modules;
+
+    DWORD modCount = std::min<DWORD>(cbNeeded / sizeof(HMODULE),
+                                     sizeof(mods) / sizeof(mods[0]));
+    char name[MAX_PATH];
+
+    for (DWORD i = 0; i < modCount; ++i) {
+        MODULEINFO mi{};
+        if (!GetModuleInformation(process, mods[i], &mi, sizeof(mi)))
+            continue;
+        if (!GetModuleBaseNameA(process, mods[i], name, MAX_PATH))
+            continue;
+
+        ModuleInfo m;
+        m.name = name;
+        m.base = reinterpret_cast<uintptr_t>(mi.lpBaseOfDll);
+        m.size = mi.SizeOfImage;
+        modules.push_back(std::move(m));
+    }
+
+    std::sort(modules.begin(), modules.end(),
+              [](const ModuleInfo& a, const ModuleInfo& b) { return a.base < b.base; });
+    return modules;
+}
+
+#endif // _WIN32
+
+// =====================================================================
+//  Linux
+// =====================================================================
+#if defined(__linux__)
+
+size_t LinuxMemorySource::Read(uintptr_t addr, void* dst, size_t size)
+{
+    if (size == 0) return 0;
+    iovec local{ dst, size };
+    iovec remote{ reinterpret_cast<void*>(addr), size };
+
+    // Stops at the first unreadable page and reports the prefix
+    ssize_t n = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+// One process_vm_readv per IOV_MAX requests.  The kernel stops at the
+// first remote iovec it can't read, so after a short transfer the
+// failed request is marked and the call resumes after it.
+size_t LinuxMemorySource::ReadBatch(ReadRequest* reqs, size_t count)
+{
+    constexpr size_t kMaxIov = IOV_MAX;
+    iovec local[kMaxIov];
+    iovec remote[kMaxIov];
+
+    size_t ok = 0;
+    size_t i = 0;
+    while (i < count) {
+        size_t n = std::min(kMaxIov, count - i);
+        for (size_t k = 0; k < n; ++k) {
+            local[k]  = { reqs[i + k].dst, reqs[i + k].size };
+            remote[k] = { reinterpret_cast<void*>(reqs[i + k].address), reqs[i + k].size };
+        }
+
+        ssize_t got = process_vm_readv(pid, local, n, remote, n, 0);
+        size_t left = got > 0 ? static_cast<size_t>(got) : 0;
+
+        size_t k = 0;
+        for (; k < n && left >= reqs[i + k].size; ++k) {
+            left -= reqs[i + k].size;
+            reqs[i + k].ok = true;
+            ++ok;
+        }
+        if (k < n) reqs[i + k++].ok = false;    // the one that stopped it
+        i += k;
+    }
+    return ok;
+}
+
+static bool ParseMapsLine(const std::string& line, MemoryRegion& r,
+                          std::string& path, bool& readable)
+{
+    std::istringstream ss(line);
+    std::string range, perms, offset, dev, inode;
+    if (!(ss >> range >> perms >> offset >> dev >> inode)) return false;
+    std::getline(ss >> std::ws, path);
+
+    auto dash = range.find('-');
+    if (dash == std::string::npos || perms.size() < 4) return false;
+    uintptr_t start = std::stoull(range.substr(0, dash), nullptr, 16);
+    uintptr_t end   = std::stoull(range.substr(dash + 1), nullptr, 16);
+
+    bool rd = perms[0] == 'r', wr = perms[1] == 'w', ex = perms[2] == 'x';
+    readable = rd && path != "[vvar]" && path != "[vsyscall]";
+
+    r.base    = start;
+    r.size    = static_cast<size_t>(end - start);
+    r.protect = ex ? (wr ? mem_prot::ExecuteReadWrite : mem_prot::ExecuteRead)
+                   : (wr ? mem_prot::ReadWrite : mem_prot::ReadOnly);
+    r.type    = (!path.empty() && path[0] == '/') ? mem_type::Image : mem_type::Private;
+    return true;
+}
+
+std::vector<MemoryRegion> LinuxMemorySource::Regions()
+{
+    std::vector<MemoryRegion> regions;
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::string line, path;
+
+    while (std::getline(maps, line)) {
+        MemoryRegion r;
+        bool readable = false;
+        if (ParseMapsLine(line, r, path, readable) && readable)
+            regions.push_back(r);
+    }
+    return regions;
+}
+
+std::vector<ModuleInfo> LinuxMemorySource::Modules()
+{
+    std::vector<ModuleInfo> modules;
+    std::map<std::string, size_t> byPath;
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::string line, path;
+
+    while (std::getline(maps, line)) {
+        MemoryRegion r;
+        bool readable = false;
+        if (!ParseMapsLine(line, r, path, readable) || r.type != mem_type::Image)
+            continue;
+
+        auto it = byPath.find(path);
+        if (it == byPath.end()) {
+            ModuleInfo m;
+            m.name = path.substr(path.find_last_of('/') + 1);
+            m.base = r.base;
+            m.size = r.size;
+            byPath[path] = modules.size();
+            modules.push_back(std::move(m));
+        } else {
+            auto& m = modules[it->second];
+            uintptr_t end = std::max(m.base + m.size, r.base + r.size);
+            m.base = std::min(m.base, r.base);
+            m.size = static_cast<size_t>(end - m.base);
+        }
+    }
+
+    std::sort(modules.begin(), modules.end(),
+              [](const ModuleInfo& a, const ModuleInfo& b) { return a.base < b.base; });
+    return modules;
+}
+
+#endif // __linux__
+
+// =====================================================================
+//  Snapshot
+// =====================================================================
+
+void SnapshotMemorySource::AddRegion(const MemoryRegion& region, const void* data)
+{
+    Stored s;
+    s.info = region;
+    s.bytes.resize(region.size);
+    if (data && region.size)
+        std::memcpy(s.bytes.data(), data, region.size);
+    regions[region.base] = std::move(s);
+}
+
+void SnapshotMemorySource::AddModule(const ModuleInfo& module)
+{
+    modules.push_back(module);
+    std::sort(modules.begin(), modules.end(),
+              [](const ModuleInfo& a, const ModuleInfo& b) { return a.base < b.base; });
+}
+
+size_t SnapshotMemorySource::Capture(MemorySource& src)
+{
+    Clear();
+    size_t total = 0;
+
+    for (const auto& r : src.Regions()) {
+        Stored s;
+        s.info = r;
+        s.bytes.resize(r.size);
+        size_t got = src.Read(r.base, s.bytes.data(), r.size);
+        if (got == 0) continue;
+
+        s.bytes.resize(got);
+        s.info.size = got;
+        total += got;
+        regions[r.base] = std::move(s);
+    }
+    modules = src.Modules();
+    return total;
+}
+
+void SnapshotMemorySource::Clear()
+{
+    regions.clear();
+    modules.clear();
+}
+
+const uint8_t* SnapshotMemorySource::Data(uintptr_t addr, size_t size) const
+{
+    auto it = regions.upper_bound(addr);
+    if (it == regions.begin()) return nullptr;
+    --it;
+    const auto& s = it->second;
+    if (addr - s.info.base > s.bytes.size() ||
+        size > s.bytes.size() - (addr - s.info.base))
+        return nullptr;
+    return s.bytes.data() + (addr - s.info.base);
+}
+
+uint8_t* SnapshotMemorySource::Data(uintptr_t addr, size_t size)
+{
+    return const_cast<uint8_t*>(
+        static_cast<const SnapshotMemorySource*>(this)->Data(addr, size));
+}
+
+size_t SnapshotMemorySource::Read(uintptr_t addr, void* dst, size_t size)
+{
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t done = 0;
+
+    // Walk adjacent regions; stop at the first gap
+    auto it = regions.upper_bound(addr);
+    if (it == regions.begin()) return 0;
+    --it;
+
+    while (done < size && it != regions.end()) {
+        const auto& s = it->second;
+        uintptr_t cur = addr + done;
+        if (cur < s.info.base || cur >= s.info.base + s.bytes.size()) break;
+
+        size_t n = std::min(size - done,
+                            static_cast<size_t>(s.info.base + s.bytes.size() - cur));
+        std::memcpy(out + done, s.bytes.data() + (cur - s.info.base), n);
+        done += n;
+        ++it;
+    }
+    return done;
+}
+
+std::vector<MemoryRegion> SnapshotMemorySource::Regions()
+{
+    std::vector<MemoryRegion> out;
+    out.reserve(regions.size());
+    for (const auto& [base, s] : regions)
+        out.push_back(s.info);
+    return out;
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+// ── Memory sources ───────────────────────────────────────────────────
+// Everything that reads target memory (scanner, value / pointer scans,
+// EntityReader) goes through a MemorySource instead of calling
+// ReadProcessMemory directly, so the same code runs against a live
+// Windows process, a live Linux process, or a captured snapshot.
+//
+// Implementations must allow concurrent Read() calls; the scanners
+// read from a worker pool.  The concrete sources are `final`, so code
+// holding one by its concrete type (ReadValue<T>(win32Source, ...))
+// gets direct, inlinable calls with nothing added over the raw syscall.
+
+// Region protection / type, using the Win32 PAGE_* / MEM_* values on
+// every platform (Linux maps are translated).
+namespace mem_prot {
+    constexpr uint32_t NoAccess         = 0x01;
+    constexpr uint32_t ReadOnly         = 0x02;
+    constexpr uint32_t ReadWrite        = 0x04;
+    constexpr uint32_t WriteCopy        = 0x08;
+    constexpr uint32_t Execute          = 0x10;
+    constexpr uint32_t ExecuteRead      = 0x20;
+    constexpr uint32_t ExecuteReadWrite = 0x40;
+    constexpr uint32_t ExecuteWriteCopy = 0x80;
+}
+
+namespace mem_type {
+    constexpr uint32_t Private = 0x20000;
+    constexpr uint32_t Mapped  = 0x40000;
+    constexpr uint32_t Image   = 0x1000000;
+}
+
+// A committed, readable region of the target.
+struct MemoryRegion {
+    uintptr_t base    = 0;
+    size_t    size    = 0;
+    uint32_t  protect = 0;      // mem_prot::*
+    uint32_t  type    = 0;      // mem_type::*
+};
+
+// A loaded module image of the target.
+struct ModuleInfo {
+    std::string name;          // file name, e.g. "jvm.dll"
+    uintptr_t   base = 0;
+    size_t      size = 0;
+};
+
+// One entry of a batch read.
+struct ReadRequest {
+    uintptr_t address = 0;
+    size_t    size    = 0;
+    void*     dst     = nullptr;
+    bool      ok      = false;  // set by ReadBatch: all `size` bytes read
+};
+
+// =====================================================================
+//  MemorySource — abstract read access to a target address space
+// =====================================================================
+class MemorySource {
+public:
+    virtual ~MemorySource() = default;
+
+    // Copy [addr, addr + size) into dst.  Returns the number of bytes
+    // copied: a prefix of the range when it runs into unreadable memory.
+    virtual size_t Read(uintptr_t addr, void* dst, size_t size) = 0;
+
+    // Committed, readable regions, sorted by base.
+    virtual std::vector<MemoryRegion> Regions() = 0;
+
+    // Loaded modules, sorted by base.  Empty if unknown.
+    virtual std::vector<ModuleInfo> Modules() { return {}; }
+
+    // Fulfil every request, setting its `ok` flag.  Returns the number
+    // of successful requests.  The default issues one Read() each.
+    virtual size_t ReadBatch(ReadRequest* reqs, size_t count);
+
+    // False once the target is gone (or was never attached).
+    virtual bool Valid() const { return true; }
+};
+
+// ── Typed helpers ────────────────────────────────────────────────────
+// Templated on the source type so concrete (final) sources skip the
+// virtual call.
+template <typename T, typename Source>
+std::optional<T> ReadValue(Source& src, uintptr_t addr)
+{
+    T value{};
+    if (src.Read(addr, &value, sizeof(T)) == sizeof(T))
+        return value;
+    return std::nullopt;
+}
+
+template <typename Source>
+bool ReadExact(Source& src, uintptr_t addr, void* dst, size_t size)
+{
+    return src.Read(addr, dst, size) == size;
+}
+
+// Into caller-owned storage; returns the bytes copied (a prefix on a
+// partial read).  Nothing is allocated.
+template <typename Source>
+size_t ReadBytes(Source& src, uintptr_t addr, std::span<uint8_t> out)
+{
+    return src.Read(addr, out.data(), out.size());
+}
+
+// `count` contiguous T (an int[] / double[] / oop slice) into `out`.
+// Returns the number of whole elements read.
+template <typename T, typename Source>
+size_t ReadArray(Source& src, uintptr_t addr, size_t count, T* out)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    return src.Read(addr, out, count * sizeof(T)) / sizeof(T);
+}
+
+template <typename T, typename Source>
+size_t ReadArray(Source& src, uintptr_t addr, std::span<T> out)
+{
+    return ReadArray(src, addr, out.size(), out.data());
+}
+
+// Per-thread scratch buffer of at least `size` bytes.  It only allocates
+// when it has to grow, so steady-state callers reuse the same memory.
+// Valid until the next ScratchBuffer() call on the same thread.
+std::span<uint8_t> ScratchBuffer(size_t size);
+
+// Read into the calling thread's scratch buffer; returns the bytes that
+// arrived (empty on failure).  Same lifetime as ScratchBuffer().
+template <typename Source>
+std::span<const uint8_t> ReadScratch(Source& src, uintptr_t addr, size_t size)
+{
+    auto buf = ScratchBuffer(size);
+    return buf.first(src.Read(addr, buf.data(), size));
+}
+
+// ── Scatter-gather ───────────────────────────────────────────────────
+// ReadBatch for sources that pay per call but little per byte
+// (ReadProcessMemory): requests are sorted by address and requests no
+// more than kCoalesceGap apart are merged into one range read of at
+// most kCoalesceSpan bytes, then copied out.  A request the range read
+// didn't cover is retried on its own, so one bad page only fails the
+// requests that touch it.
+constexpr size_t kCoalesceGap  = 4096;
+constexpr size_t kCoalesceSpan = 64 * 1024;
+
+size_t ReadBatchCoalesced(MemorySource& src, ReadRequest* reqs, size_t count);
+
+// =====================================================================
+//  Platform sources
+// =====================================================================
+
+#if defined(_WIN32)
+// Live Windows process via ReadProcessMemory / VirtualQueryEx.
+// Does not own the handle.
+class Win32MemorySource final : public MemorySource {
+public:
+    Win32MemorySource() = default;
+    explicit Win32MemorySource(HANDLE process) : process(process) {}
+
+    void   Attach(HANDLE h) { process = h; }
+    HANDLE Handle() const   { return process; }
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override
+    {
+        // A failed read can still have copied a prefix (ERROR_PARTIAL_COPY
+        // when the range runs into an unreadable page); keep what arrived.
+        SIZE_T bytesRead = 0;
+        ReadProcessMemory(process, reinterpret_cast<LPCVOID>(addr),
+                          dst, size, &bytesRead);
+        return static_cast<size_t>(bytesRead);
+    }
+
+    // Coalesced range reads (ReadBatchCoalesced).
+    size_t ReadBatch(ReadRequest* reqs, size_t count) override
+    {
+        return ReadBatchCoalesced(*this, reqs, count);
+    }
+
+    std::vector<MemoryRegion> Regions() override;
+    std::vector<ModuleInfo>   Modules() override;
+    bool Valid() const override { return process != nullptr; }
+
+private:
+    HANDLE process = nullptr;
+};
+#endif
+
+#if defined(__linux__)
+// Live Linux process via process_vm_readv and /proc/<pid>/maps.
+// Modules are the file-backed mappings, one per path.
+class LinuxMemorySource final : public MemorySource {
+public:
+    LinuxMemorySource() = default;
+    explicit LinuxMemorySource(int pid) : pid(pid) {}
+
+    void Attach(int p) { pid = p; }
+    int  Pid() const   { return pid; }
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override;
+    size_t ReadBatch(ReadRequest* reqs, size_t count) override;
+    std::vector<MemoryRegion> Regions() override;
+    std::vector<ModuleInfo>   Modules() override;
+    bool Valid() const override { return pid > 0; }
+
+private:
+    int pid = 0;
+};
+#endif
+
+// =====================================================================
+//  SnapshotMemorySource — frozen copy of an address space in memory
+// =====================================================================
+// Regions are copied in with AddRegion() or Capture() and served from
+// local memory, so scanner / reader runs are reproducible off the
+// target machine.
+class SnapshotMemorySource final : public MemorySource {
+public:
+    // Add (or replace) a region with the given contents.
+    void AddRegion(const MemoryRegion& region, const void* data);
+    void AddModule(const ModuleInfo& module);
+
+    // Copy every readable region and the module list of `src`.
+    // Returns the number of bytes captured.
+    size_t Capture(MemorySource& src);
+
+    void Clear();
+
+    // Direct pointer to [addr, addr + size) if it lies inside one region.
+    uint8_t*       Data(uintptr_t addr, size_t size);
+    const uint8_t* Data(uintptr_t addr, size_t size) const;
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override;
+    std::vector<MemoryRegion> Regions() override;
+    std::vector<ModuleInfo>   Modules() override { return modules; }
+
+private:
+    struct Stored {
+        MemoryRegion         info;
+        std::vector<uint8_t> bytes;
+    };
+    std::map<uintptr_t, Stored> regions;     // by base, non-overlapping
+    std::vector<ModuleInfo>     modules;
+};
@@ -0,0 +1,296 @@
+#include "multi_pattern.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define WD42_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang only emit AVX2 instructions inside functions that opt in
+#if defined(WD42_X86) && (defined(__GNUC__) || defined(__clang__))
+#define WD42_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WD42_TARGET_AVX2
+#endif
+
+// ─────────────────────────────────────────────────────────────────────
+size_t MultiPatternMatcher::AddPattern(const PatternView& pattern)
+{
+    size_t id = patterns.size();
+    patterns.push_back(CompilePattern(pattern));
+    maxLength = std::max(maxLength, pattern.length);
+
+    // Longest contiguous run of exact bytes becomes the automaton key
+    const uint8_t* mask = pattern.mask;
+    size_t bestOff = 0, bestLen = 0;
+    for (size_t i = 0; i < pattern.length; ) {
+        if (!mask[i]) { ++i; continue; }
+        size_t j = i;
+        while (j < pattern.length && mask[j]) ++j;
+        if (j - i > bestLen) {
+            bestOff = i;
+            bestLen = j - i;
+        }
+        i = j;
+    }
+
+    if (bestLen == 0) {
+        if (pattern.length) fallback.push_back(id);
+        return id;
+    }
+
+    KeyEntry k;
+    k.patternId   = id;
+    k.keyOffset   = bestOff;
+    k.keyLength   = bestLen;
+    k.needsVerify = (bestLen != pattern.length);
+    keys.push_back(k);
+    return id;
+}
+
+// ── Aho-Corasick construction ────────────────────────────────────────
+void MultiPatternMatcher::Build()
+{
+    // 1. Trie of all keys (-1 = no edge yet)
+    next.assign(256, -1);
+    std::vector<std::vector<uint32_t>> out(1);
+
+    for (size_t ki = 0; ki < keys.size(); ++ki) {
+        const KeyEntry& k = keys[ki];
+        const CompiledPattern& p = patterns[k.patternId];
+
+        int32_t s = 0;
+        for (size_t j = 0; j < k.keyLength; ++j) {
+            uint8_t c = p.bytes[k.keyOffset + j];
+            if (next[s * 256 + c] < 0) {
+                next[s * 256 + c] = static_cast<int32_t>(out.size());
+                next.resize(next.size() + 256, -1);
+                out.emplace_back();
+            }
+            s = next[s * 256 + c];
+        }
+        out[s].push_back(static_cast<uint32_t>(ki));
+    }
+
+    // 2. BFS: failure links, folded straight into a full DFA
+    size_t states = out.size();
+    std::vector<int32_t> fail(states, 0);
+    std::deque<int32_t> queue;
+
+    for (int c = 0; c < 256; ++c) {
+        int32_t t = next[c];
+        if (t < 0) {
+            next[c] = 0;
+        } else {
+            fail[t] = 0;
+            queue.push_back(t);
+        }
+    }
+
+    while (!queue.empty()) {
+        int32_t s = queue.front();
+        queue.pop_front();
+
+        // Inherit outputs from the failure state (already complete,
+        // since it is shallower in BFS order)
+        const auto& inherited = out[fail[s]];
+        out[s].insert(out[s].end(), inherited.begin(), inherited.end());
+
+        for (int c = 0; c < 256; ++c) {
+            int32_t t = next[s * 256 + c];
+            if (t < 0) {
+                next[s * 256 + c] = next[fail[s] * 256 + c];
+            } else {
+                fail[t] = next[fail[s] * 256 + c];
+                queue.push_back(t);
+            }
+        }
+    }
+
+    // 3. Flatten outputs (CSR)
+    outStart.assign(states + 1, 0);
+    outputs.clear();
+    for (size_t s = 0; s < states; ++s) {
+        outStart[s] = static_cast<uint32_t>(outputs.size());
+        outputs.insert(outputs.end(), out[s].begin(), out[s].end());
+    }
+    outStart[states] = static_cast<uint32_t>(outputs.size());
+
+    // 4. Pre-multiply targets by 256 and tag states that have outputs
+    //    in bit 0, so the hot loop is a single dependent load per byte.
+    for (auto& t : next)
+        t = (t << 8) | (out[t].empty() ? 0 : 1);
+
+    // 5. Prefilter tables.  Keys sharing a first byte share a bucket,
+    //    which keeps each bucket's byte sets (and nibble cross
+    //    products) small.
+    rootByte = keys.empty() ? -1 : patterns[keys[0].patternId].bytes[keys[0].keyOffset];
+    std::memset(bucketsAt, 0, sizeof(bucketsAt));
+    std::memset(loMask, 0, sizeof(loMask));
+    std::memset(hiMask, 0, sizeof(hiMask));
+    for (const KeyEntry& k : keys) {
+        const uint8_t* key = patterns[k.patternId].bytes.data() + k.keyOffset;
+        if (key[0] != rootByte) rootByte = -1;
+        uint8_t bucket = static_cast<uint8_t>(1u << (key[0] % kBuckets));
+        bucketsAt[0][key[0]] |= bucket;
+        if (k.keyLength > 1) {
+            bucketsAt[1][key[1]] |= bucket;
+        } else {
+            for (int c = 0; c < 256; ++c) bucketsAt[1][c] |= bucket;
+        }
+    }
+    for (int j = 0; j < 2; ++j) {
+        for (int c = 0; c < 256; ++c) {
+            loMask[j][c & 15] |= bucketsAt[j][c];
+            hiMask[j][c >> 4] |= bucketsAt[j][c];
+        }
+    }
+}
+
+// ── Prefilter ────────────────────────────────────────────────────────
+
+#if defined(WD42_X86)
+static inline unsigned LowestBit(unsigned v)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, v);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+// Positions i.. in steps of 32 while byte pairs (p, p + 1) fit no
+// bucket: each byte's nibbles index the 16-entry masks (pshufb), and
+// a position survives if all four lookups share a bucket bit.  Returns
+// the first candidate, or where fewer than 33 bytes are left.
+WD42_TARGET_AVX2
+static size_t SkipAVX2(const uint8_t* buf, size_t i, size_t size,
+                       const uint8_t (*lo)[16], const uint8_t (*hi)[16])
+{
+#define WD42_TABLE(t) _mm256_broadcastsi128_si256( \
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(t)))
+    const __m256i lo0 = WD42_TABLE(lo[0]), hi0 = WD42_TABLE(hi[0]);
+    const __m256i lo1 = WD42_TABLE(lo[1]), hi1 = WD42_TABLE(hi[1]);
+#undef WD42_TABLE
+    const __m256i nib = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (; i + 33 <= size; i += 32) {
+        __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf + i));
+        __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf + i + 1));
+        __m256i c0 = _mm256_and_si256(
+            _mm256_shuffle_epi8(lo0, _mm256_and_si256(d0, nib)),
+            _mm256_shuffle_epi8(hi0, _mm256_and_si256(_mm256_srli_epi16(d0, 4), nib)));
+        __m256i c1 = _mm256_and_si256(
+            _mm256_shuffle_epi8(lo1, _mm256_and_si256(d1, nib)),
+            _mm256_shuffle_epi8(hi1, _mm256_and_si256(_mm256_srli_epi16(d1, 4), nib)));
+        unsigned miss = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_and_si256(c0, c1), zero)));
+        if (miss != 0xFFFFFFFFu)
+            return i + LowestBit(~miss);
+    }
+    return i;
+}
+#endif
+
+size_t MultiPatternMatcher::SkipToCandidate(const uint8_t* buf, size_t i,
+                                            size_t size) const
+{
+    // A single first byte: memchr beats the pair test, and the DFA
+    // drops the false starts just as fast
+    if (rootByte >= 0) {
+        const void* hit = std::memchr(buf + i, rootByte, size - i);
+        return hit ? static_cast<size_t>(static_cast<const uint8_t*>(hit) - buf)
+                   : size;
+    }
+
+#if defined(WD42_X86)
+    if (BestScanKernel() == ScanKernel::AVX2) {
+        i = SkipAVX2(buf, i, size, loMask, hiMask);
+        if (i + 33 <= size) return i;
+    }
+#endif
+
+    // Exact per-byte tables; the last byte can only start a 1-byte key,
+    // so it is left to the DFA
+    for (; i + 1 < size; ++i) {
+        if (bucketsAt[0][buf[i]] & bucketsAt[1][buf[i + 1]])
+            return i;
+    }
+    return i;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+void MultiPatternMatcher::Find(const uint8_t* buf, size_t size,
+                               std::vector<PatternMatch>& out,
+                               Scratch& scratch) const
+{
+    size_t first = out.size();
+
+    if (!keys.empty()) {
+        const int32_t*  dfa   = next.data();
+        const uint32_t* start = outStart.data();
+        int32_t v = 0;
+
+        for (size_t i = 0; i < size; ++i) {
+            // In the root state no key is under way: jump to the next
+            // position that can start one
+            if (v == 0) {
+                i = SkipToCandidate(buf, i, size);
+                if (i == size) break;
+            }
+
+            v = dfa[(v & ~1) + buf[i]];
+            if (!(v & 1)) continue;
+
+            // Key ended at byte i: derive each pattern's start and verify
+            int32_t s = v >> 8;
+            for (uint32_t o = start[s]; o < start[s + 1]; ++o) {
+                const KeyEntry& k = keys[outputs[o]];
+                size_t back = k.keyOffset + k.keyLength;
+                if (i + 1 < back) continue;
+
+                size_t pos = i + 1 - back;
+                const CompiledPattern& p = patterns[k.patternId];
+                if (pos + p.length > size) continue;
+
+                if (k.needsVerify) {
+                    bool match = true;
+                    for (size_t j = 0; j < p.length; ++j) {
+                        if (p.mask[j] && buf[pos + j] != p.bytes[j]) {
+                            match = false;
+                            break;
+                        }
+                    }
+                    if (!match) continue;
+                }
+                out.push_back({ pos, k.patternId });
+            }
+        }
+    }
+
+    // Wildcard-only patterns: no key to anchor, use the plain kernel
+    if (!fallback.empty()) {
+        auto& offsets = scratch.offsets;
+        for (size_t id : fallback) {
+            offsets.clear();
+            FindMatches(buf, size, patterns[id], offsets);
+            for (size_t off : offsets)
+                out.push_back({ off, id });
+        }
+    }
+
+    std::sort(out.begin() + first, out.end(),
+        [](const PatternMatch& a, const PatternMatch& b) {
+            if (a.offset != b.offset) return a.offset < b.offset;
+            return a.patternId < b.patternId;
+        });
+}
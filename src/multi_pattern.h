@@ -0,0 +1,88 @@
+#pragma once
+
+#include "scan_kernels.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ── Multi-pattern matcher ────────────────────────────────────────────
+// Finds any number of wildcard patterns in a single pass over a buffer.
+//
+// Each pattern contributes its longest run of exact bytes as a key to
+// one Aho-Corasick automaton (dense 256-way DFA).  When a key is seen,
+// the full masked pattern is verified around it.  Patterns with no
+// exact bytes at all fall back to the single-pattern kernels.
+//
+// Stepping the DFA costs a dependent table load per byte, so it only
+// runs from candidate positions.  A Teddy-style prefilter puts the keys
+// in 8 buckets and tests the first two bytes of every position against
+// each bucket's nibble masks, 32 positions at a time (AVX2; otherwise
+// one lookup per byte in two 256-entry tables), and skips ahead to the
+// next position that could start a key (when every key starts with the
+// same byte, libc's memchr for it instead).  Scan time therefore follows
+// the candidate rate: it grows as more keys share common leading byte
+// pairs, not with the pattern count as such.
+
+struct PatternMatch {
+    size_t offset    = 0;   // start of the match within the buffer
+    size_t patternId = 0;   // index in AddPattern() order
+};
+
+class MultiPatternMatcher {
+public:
+    // Add a pattern.  Returns its id.
+    size_t AddPattern(const PatternView& pattern);
+
+    // Build the automaton.  Must be called after the last AddPattern().
+    void Build();
+
+    size_t PatternCount() const { return patterns.size(); }
+
+    // Longest pattern; callers splitting buffers overlap by this - 1.
+    size_t MaxLength() const { return maxLength; }
+
+    // Working storage for Find(), owned by the caller (one per thread)
+    // so repeated calls don't allocate.
+    struct Scratch {
+        std::vector<size_t> offsets;
+    };
+
+    // Append every match in `buf[0..size)` to `out`, sorted by offset
+    // then pattern id.
+    void Find(const uint8_t* buf, size_t size,
+              std::vector<PatternMatch>& out, Scratch& scratch) const;
+
+private:
+    struct KeyEntry {
+        size_t patternId   = 0;
+        size_t keyOffset   = 0;    // where the key starts in the pattern
+        size_t keyLength   = 0;
+        bool   needsVerify = false; // pattern has bytes outside the key
+    };
+
+    std::vector<CompiledPattern> patterns;
+    std::vector<KeyEntry>        keys;
+    std::vector<size_t>          fallback;   // patterns with no exact byte
+    size_t                       maxLength = 0;
+
+    // DFA: next[state * 256 + byte] = (target << 8) | hasOutputs.
+    // outputs[outStart[s]..outStart[s+1]) lists the KeyEntry indices
+    // that end in state s.
+    std::vector<int32_t>  next;
+    std::vector<uint32_t> outStart;
+    std::vector<uint32_t> outputs;
+
+    // Prefilter.  bucketsAt[j][c]: buckets with a key whose byte j is
+    // c (byte 1 of a 1-byte key: any).  loMask / hiMask: the same per
+    // low / high nibble, a superset the vector path can look up with
+    // byte shuffles.
+    static constexpr int kBuckets = 8;
+    int     rootByte = -1;          // first byte of every key, if they share one
+    uint8_t bucketsAt[2][256] = {};
+    uint8_t loMask[2][16] = {};
+    uint8_t hiMask[2][16] = {};
+
+    // First j >= i that may start a key (or size).
+    size_t SkipToCandidate(const uint8_t* buf, size_t i, size_t size) const;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// ── Worker pool ──────────────────────────────────────────────────────
+// Run fn(item) for item in [0, items) on up to `threads` workers
+// (0 = one per hardware thread).  Items are handed out dynamically, so
+// uneven items balance themselves.  Blocks until every item is done.
+template <typename Fn>
+void ParallelFor(size_t items, unsigned threads, Fn&& fn)
+{
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > items) threads = static_cast<unsigned>(std::max<size_t>(1, items));
+
+    std::atomic<size_t> next{ 0 };
+    auto work = [&]() {
+        for (size_t i = next.fetch_add(1); i < items; i = next.fetch_add(1))
+            fn(i);
+    };
+
+    if (threads <= 1) {
+        work();
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+        pool.emplace_back(work);
+    for (auto& th : pool)
+        th.join();
+}
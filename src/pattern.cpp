@@ -0,0 +1,26 @@
+#include "pattern.h"
+
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────────────
+ParsedPattern ParsePattern(std::string_view pattern)
+{
+    ParsedPattern p;
+    bool ok = pattern_detail::ForEachToken(pattern, [&](uint8_t b, bool exact) {
+        p.bytes.push_back(b);
+        p.mask.push_back(exact ? 0xFF : 0x00);
+    });
+
+    if (!ok) return {};
+    return p;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+ParsedPattern PatternFromBytes(const void* data, size_t size)
+{
+    ParsedPattern p;
+    p.bytes.resize(size);
+    if (size) std::memcpy(p.bytes.data(), data, size);
+    p.mask.assign(size, 0xFF);
+    return p;
+}
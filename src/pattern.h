@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// ── Byte patterns ────────────────────────────────────────────────────
+// Pattern format: "48 8B 05 ?? ?? ?? ?? 48 85 C0"
+//   - Two hex chars = exact byte match
+//   - "??" or "?"   = wildcard (matches any byte)
+//
+// Two representations share one grammar:
+//   ParsedPattern   runtime, parsed from user input or built from bytes
+//   Pattern<"...">  compile-time, validated and laid out by the compiler
+// Both hand the scan kernels a PatternView.
+
+// Non-owning view of a pattern.  mask[i] is 0xFF when bytes[i] must
+// match exactly and 0x00 for a wildcard.
+struct PatternView {
+    const uint8_t* bytes  = nullptr;
+    const uint8_t* mask   = nullptr;
+    size_t         length = 0;
+};
+
+struct ParsedPattern {
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;    // 0xFF = must match, 0x00 = wildcard
+
+    PatternView View() const { return { bytes.data(), mask.data(), bytes.size() }; }
+};
+
+// Parse a pattern string.  Returns an empty pattern if any token is not
+// a wildcard or a two-digit hex byte.
+ParsedPattern ParsePattern(std::string_view pattern);
+
+// Exact-match pattern for a raw byte string (e.g. a class name).
+ParsedPattern PatternFromBytes(const void* data, size_t size);
+
+inline ParsedPattern PatternFromString(std::string_view text)
+{
+    return PatternFromBytes(text.data(), text.size());
+}
+
+// ── Shared tokenizer ─────────────────────────────────────────────────
+namespace pattern_detail {
+
+constexpr int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+constexpr bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Calls onToken(byte, exact) per token.  Returns false on a bad token.
+template <typename Fn>
+constexpr bool ForEachToken(std::string_view s, Fn&& onToken)
+{
+    size_t i = 0;
+    while (i < s.size()) {
+        if (IsSpace(s[i])) { ++i; continue; }
+
+        size_t j = i;
+        while (j < s.size() && !IsSpace(s[j])) ++j;
+        std::string_view tok = s.substr(i, j - i);
+        i = j;
+
+        if (tok == "?" || tok == "??") {
+            onToken(uint8_t{ 0 }, false);
+        } else if (tok.size() == 2 && HexDigit(tok[0]) >= 0 && HexDigit(tok[1]) >= 0) {
+            onToken(static_cast<uint8_t>(HexDigit(tok[0]) * 16 + HexDigit(tok[1])), true);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rough frequency class of a byte in x64 code + JVM heap data.
+// Lower = rarer = better anchor for candidate search.
+constexpr int ByteCommonness(uint8_t b)
+{
+    switch (b) {
+    case 0x00:                                          return 100;
+    case 0xFF:                                          return 90;
+    case 0x48: case 0x8B: case 0x89: case 0x0F:
+    case 0x01: case 0xCC: case 0x20:                    return 70;
+    case 0x4C: case 0x8D: case 0x24: case 0xE8:
+    case 0x85: case 0xC0: case 0x83: case 0x44:
+    case 0x08: case 0x10: case 0x02: case 0x04:
+    case 0x03: case 0xFE: case 0x80:                    return 50;
+    default: break;
+    }
+    if ((b >= 'a' && b <= 'z') || (b >= '0' && b <= '9') ||
+        b == '/' || b == '.' || b == '_')
+        return 30;
+    if (b >= 'A' && b <= 'Z')
+        return 20;
+    return 10;
+}
+
+} // namespace pattern_detail
+
+// ── Compile-time patterns ────────────────────────────────────────────
+// Pattern<"48 8B 05 ?? ?? ?? ?? 48 85 C0"> (or "48 8B ..."_pat) parses
+// and validates the string during compilation; a malformed token is a
+// compile error.  The bytes and mask are constexpr arrays, so nothing
+// is parsed at runtime; scans hand them to the same vector kernels as
+// a ParsedPattern.
+
+template <size_t N>
+struct FixedString {
+    char text[N] = {};
+
+    constexpr FixedString(const char (&s)[N])
+    {
+        for (size_t i = 0; i < N; ++i) text[i] = s[i];
+    }
+
+    constexpr std::string_view View() const { return { text, N - 1 }; }
+};
+
+template <FixedString S>
+struct Pattern {
+private:
+    static constexpr size_t CountTokens()
+    {
+        size_t n = 0;
+        bool ok = pattern_detail::ForEachToken(S.View(),
+            [&](uint8_t, bool) { ++n; });
+        // Not a constant expression -> "invalid pattern" compile error
+        if (!ok) throw "invalid pattern token";
+        return n;
+    }
+
+public:
+    static constexpr size_t length = CountTokens();
+    static_assert(length > 0, "empty pattern");
+
+private:
+    struct Layout {
+        std::array<uint8_t, length> bytes{};
+        std::array<uint8_t, length> mask{};
+    };
+
+    static constexpr Layout Build()
+    {
+        Layout l{};
+        size_t i = 0;
+        pattern_detail::ForEachToken(S.View(), [&](uint8_t b, bool exact) {
+            l.bytes[i] = b;
+            l.mask[i]  = exact ? 0xFF : 0x00;
+            ++i;
+        });
+        return l;
+    }
+
+    static constexpr Layout layout = Build();
+
+public:
+    static constexpr std::array<uint8_t, length> bytes = layout.bytes;
+    static constexpr std::array<uint8_t, length> mask  = layout.mask;
+
+    static PatternView View() { return { bytes.data(), mask.data(), length }; }
+
+    static ParsedPattern ToParsed()
+    {
+        return { { bytes.begin(), bytes.end() }, { mask.begin(), mask.end() } };
+    }
+};
+
+template <FixedString S>
+constexpr Pattern<S> operator""_pat()
+{
+    return {};
+}
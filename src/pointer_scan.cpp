@@ -0,0 +1,652 @@
+#include "pointer_scan.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+
+static constexpr size_t kChunkSize = 1u << 20;   // map-build work item
+
+// =====================================================================
+//  PointerMap
+// =====================================================================
+
+void PointerMap::Clear()
+{
+    entries.clear();
+    entries.shrink_to_fit();
+    modules.clear();
+    buildMs = 0;
+}
+
+void PointerMap::Build(MemorySource& mem, unsigned threads,
+                       const std::atomic<bool>* cancel)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    Clear();
+
+    modules = mem.Modules();
+    auto regions = mem.Regions();
+    if (regions.empty()) return;
+
+    const uintptr_t lo = regions.front().base;
+    const uintptr_t hi = regions.back().base + regions.back().size;
+
+    auto pointsIntoRegion = [&](uintptr_t v) {
+        if (v < lo || v >= hi) return false;
+        auto it = std::upper_bound(regions.begin(), regions.end(), v,
+            [](uintptr_t x, const MemoryRegion& r) { return x < r.base; });
+        if (it == regions.begin()) return false;
+        --it;
+        return v < it->base + it->size;
+    };
+
+    struct Item { uintptr_t base; size_t size; };
+    std::vector<Item> items;
+    for (const auto& r : regions) {
+        for (size_t off = 0; off < r.size; off += kChunkSize)
+            items.push_back({ r.base + off, std::min(kChunkSize, r.size - off) });
+    }
+
+    std::vector<std::vector<Entry>> found(items.size());
+    ParallelFor(items.size(), threads, [&](size_t i) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) return;
+
+        thread_local std::vector<uint64_t> buf;
+        buf.resize(kChunkSize / sizeof(uint64_t));
+
+        size_t got   = mem.Read(items[i].base, buf.data(), items[i].size);
+        size_t slots = got / sizeof(uint64_t);
+        for (size_t s = 0; s < slots; ++s) {
+            uintptr_t v = static_cast<uintptr_t>(buf[s]);
+            if (pointsIntoRegion(v))
+                found[i].push_back({ v, items[i].base + s * sizeof(uint64_t) });
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& f : found) total += f.size();
+    entries.reserve(total);
+    for (auto& f : found) {
+        entries.insert(entries.end(), f.begin(), f.end());
+        std::vector<Entry>().swap(f);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.value != b.value ? a.value < b.value : a.address < b.address;
+    });
+
+    buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+std::pair<const PointerMap::Entry*, const PointerMap::Entry*>
+PointerMap::Range(uintptr_t lo, uintptr_t hi) const
+{
+    auto first = std::lower_bound(entries.begin(), entries.end(), lo,
+        [](const Entry& e, uintptr_t v) { return e.value < v; });
+    auto last = std::upper_bound(first, entries.end(), hi,
+        [](uintptr_t v, const Entry& e) { return v < e.value; });
+    return { entries.data() + (first - entries.begin()),
+             entries.data() + (last - entries.begin()) };
+}
+
+int PointerMap::ModuleAt(uintptr_t addr) const
+{
+    auto it = std::upper_bound(modules.begin(), modules.end(), addr,
+        [](uintptr_t a, const ModuleInfo& m) { return a < m.base; });
+    if (it == modules.begin()) return -1;
+    --it;
+    if (addr >= it->base + it->size) return -1;
+    return static_cast<int>(it - modules.begin());
+}
+
+// =====================================================================
+//  Canonical ordering
+// =====================================================================
+
+static bool PathLess(const PointerPath& a, const PointerPath& b)
+{
+    if (a.module != b.module) return a.module < b.module;
+    if (a.moduleOffset != b.moduleOffset) return a.moduleOffset < b.moduleOffset;
+    return a.offsets < b.offsets;
+}
+
+static bool PathEqual(const PointerPath& a, const PointerPath& b)
+{
+    return a.module == b.module && a.moduleOffset == b.moduleOffset &&
+           a.offsets == b.offsets;
+}
+
+// Drop unused modules, sort the module table by name and the paths by
+// (module, offset, chain), and remove duplicates.  Sorting by name
+// makes results from different sessions directly comparable.
+static void Canonicalize(PointerScanResult& r)
+{
+    std::vector<uint8_t> used(r.modules.size(), 0);
+    for (const auto& p : r.paths) used[p.module] = 1;
+
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < r.modules.size(); ++i)
+        if (used[i]) order.push_back(i);
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b) { return r.modules[a] < r.modules[b]; });
+
+    std::vector<uint32_t> remap(r.modules.size(), 0);
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        remap[order[i]] = i;
+        names.push_back(std::move(r.modules[order[i]]));
+    }
+    r.modules = std::move(names);
+
+    for (auto& p : r.paths) p.module = remap[p.module];
+    std::sort(r.paths.begin(), r.paths.end(), PathLess);
+    r.paths.erase(std::unique(r.paths.begin(), r.paths.end(), PathEqual),
+                  r.paths.end());
+}
+
+// =====================================================================
+//  Path search
+// =====================================================================
+
+static constexpr size_t   kLevelChunk = 256;          // frontier nodes per work item
+static constexpr uint32_t kNoEdge     = 0xFFFFFFFFu;
+
+namespace {
+
+// One slot reached by the search.  Its links lead towards the target:
+// *address + offset is the address of `parent`.
+struct Node {
+    uintptr_t address;
+    uint32_t  edges;           // head of its Edge list
+};
+
+struct Edge {
+    uint32_t parent;
+    int      offset;
+    uint32_t next;
+};
+
+// A static slot linking into `node`.
+struct Hit {
+    uint32_t node;
+    int      offset;
+    uint32_t module;
+    uint32_t moduleOffset;
+};
+
+// A slot found while expanding one level, before deduplication.
+struct Candidate {
+    uint32_t                 from;     // frontier node it links into
+    int                      module;   // -1 = not static
+    const PointerMap::Entry* entry;
+};
+
+// Emit every chain from `hit` to the target, up to `limit` in total.
+struct PathEmitter {
+    const std::vector<Node>& nodes;
+    const std::vector<Edge>& edges;
+    std::vector<PointerPath>& out;
+    size_t                   limit;
+    std::vector<int>         offsets;
+
+    void Walk(uint32_t node)
+    {
+        if (out.size() >= limit) return;
+        if (node == 0) {
+            out.push_back({ 0, 0, offsets });
+            return;
+        }
+        for (uint32_t e = nodes[node].edges; e != kNoEdge; e = edges[e].next) {
+            offsets.push_back(edges[e].offset);
+            Walk(edges[e].parent);
+            offsets.pop_back();
+        }
+    }
+};
+
+} // namespace
+
+PointerScanResult FindPointerPaths(const PointerMap& map, uintptr_t target,
+                                   const PointerScanOptions& options,
+                                   PointerScanProgress* progress)
+{
+    PointerScanOptions opts = options;
+    opts.maxDepth  = std::clamp(opts.maxDepth, 1, 16);
+    opts.maxOffset = std::max(opts.maxOffset, 0);
+
+    PointerScanProgress local;
+    PointerScanProgress& prog = progress ? *progress : local;
+    prog.links     = 0;
+    prog.paths     = 0;
+    prog.truncated = false;
+
+    PointerScanResult result;
+    for (const auto& m : map.Modules()) result.modules.push_back(m.name);
+    if (map.Size() == 0) return result;
+
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<Hit>  hits;
+    std::unordered_map<uintptr_t, uint32_t> seen;   // slot -> node
+    nodes.push_back({ target, kNoEdge });
+    seen.emplace(target, 0);
+
+    size_t levelBegin = 0, levelEnd = 1;
+    for (int depth = 1; depth <= opts.maxDepth && levelBegin < levelEnd; ++depth) {
+        prog.depth = depth;
+
+        // Expand the level in parallel; each work item collects its
+        // candidates, merged below in item order.
+        size_t width = levelEnd - levelBegin;
+        size_t items = (width + kLevelChunk - 1) / kLevelChunk;
+        std::vector<std::vector<Candidate>> found(items);
+        ParallelFor(items, opts.threads, [&](size_t i) {
+            size_t from = levelBegin + i * kLevelChunk;
+            size_t to   = std::min(from + kLevelChunk, levelEnd);
+            for (size_t n = from; n < to; ++n) {
+                if (prog.cancel.load(std::memory_order_relaxed) ||
+                    prog.links.load(std::memory_order_relaxed) >= opts.maxLinks)
+                    return;
+
+                uintptr_t addr = nodes[n].address;
+                uintptr_t lo   = addr >= static_cast<uintptr_t>(opts.maxOffset)
+                    ? addr - opts.maxOffset : 0;
+                auto [first, last] = map.Range(lo, addr);
+                for (auto e = first; e != last; ++e)
+                    found[i].push_back({ static_cast<uint32_t>(n),
+                                         map.ModuleAt(e->address), e });
+                prog.links.fetch_add(static_cast<size_t>(last - first),
+                                     std::memory_order_relaxed);
+            }
+        });
+
+        // Static slots end a path; the others become the next level,
+        // once each, with every link from this level kept.
+        const size_t nextBegin = nodes.size();
+        const bool   expand    = depth < opts.maxDepth;
+        for (const auto& f : found) {
+            for (const auto& c : f) {
+                int offset = static_cast<int>(nodes[c.from].address - c.entry->value);
+                if (c.module >= 0) {
+                    if (hits.size() < opts.maxResults) {
+                        uintptr_t base = map.Modules()[c.module].base;
+                        hits.push_back({ c.from, offset, static_cast<uint32_t>(c.module),
+                                         static_cast<uint32_t>(c.entry->address - base) });
+                    }
+                    continue;
+                }
+                if (!expand) continue;
+
+                auto [it, fresh] = seen.emplace(c.entry->address,
+                                                static_cast<uint32_t>(nodes.size()));
+                if (fresh)
+                    nodes.push_back({ c.entry->address, kNoEdge });
+                else if (it->second < nextBegin)
+                    continue;       // already reached at a shorter depth
+
+                Node& node = nodes[it->second];
+                edges.push_back({ c.from, offset, node.edges });
+                node.edges = static_cast<uint32_t>(edges.size() - 1);
+            }
+            prog.paths = hits.size();
+        }
+
+        levelBegin = nextBegin;
+        levelEnd   = nodes.size();
+
+        if (prog.cancel || prog.links >= opts.maxLinks || hits.size() >= opts.maxResults) {
+            prog.truncated = true;
+            break;
+        }
+    }
+
+    PathEmitter emit{ nodes, edges, result.paths, opts.maxResults, {} };
+    for (const auto& h : hits) {
+        size_t before = result.paths.size();
+        emit.offsets.assign(1, h.offset);
+        emit.Walk(h.node);
+        for (size_t i = before; i < result.paths.size(); ++i) {
+            result.paths[i].module       = h.module;
+            result.paths[i].moduleOffset = h.moduleOffset;
+        }
+        if (result.paths.size() >= opts.maxResults) {
+            prog.truncated = true;
+            break;
+        }
+    }
+
+    Canonicalize(result);
+    prog.paths = result.paths.size();
+    return result;
+}
+
+// =====================================================================
+//  PointerScanJob
+// =====================================================================
+
+PointerScanJob::~PointerScanJob()
+{
+    Cancel();
+    Join();
+}
+
+void PointerScanJob::Join()
+{
+    if (worker.joinable())
+        worker.join();
+}
+
+void PointerScanJob::Reset()
+{
+    Cancel();
+    Join();
+    map.Clear();
+    result    = {};
+    hasResult = false;
+}
+
+bool PointerScanJob::Start(MemorySource& mem, uintptr_t target,
+                           const PointerScanOptions& opts)
+{
+    if (Running()) return false;
+    Join();
+
+    progress.cancel    = false;
+    progress.depth     = 0;
+    progress.links     = 0;
+    progress.paths     = 0;
+    progress.truncated = false;
+    hasResult = false;
+    running.store(true, std::memory_order_release);
+
+    worker = std::thread([this, &mem, target, opts] {
+        map.Build(mem, opts.threads, &progress.cancel);
+        result    = FindPointerPaths(map, target, opts, &progress);
+        hasResult = true;
+        running.store(false, std::memory_order_release);
+    });
+    return true;
+}
+
+bool PointerScanJob::TakeResult(PointerScanResult& out)
+{
+    if (Running() || !hasResult) return false;
+    Join();
+    out = std::move(result);
+    result = {};
+    hasResult = false;
+    return true;
+}
+
+const PointerMap& PointerScanJob::Map() const
+{
+    static const PointerMap empty;
+    return Running() ? empty : map;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+uintptr_t ResolvePathBase(const PointerScanResult& result, const PointerPath& path,
+                          const std::vector<ModuleInfo>& live)
+{
+    if (path.module >= result.modules.size()) return 0;
+    const auto& name = result.modules[path.module];
+    for (const auto& m : live) {
+        if (m.name == name) return m.base + path.moduleOffset;
+    }
+    return 0;
+}
+
+std::vector<uintptr_t> ResolvePointerPaths(MemorySource& mem,
+                                           const PointerScanResult& result,
+                                           const std::vector<ModuleInfo>& live)
+{
+    size_t n = result.paths.size();
+    std::vector<uintptr_t> addr(n);
+    std::vector<uint32_t>  active;       // paths with links left to follow
+    size_t maxDepth = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        addr[i] = ResolvePathBase(result, result.paths[i], live);
+        if (addr[i] != 0 && !result.paths[i].offsets.empty())
+            active.push_back(static_cast<uint32_t>(i));
+        maxDepth = std::max(maxDepth, result.paths[i].offsets.size());
+    }
+
+    std::vector<uint64_t>    values(n);
+    std::vector<ReadRequest> batch;
+    for (size_t depth = 0; depth < maxDepth && !active.empty(); ++depth) {
+        batch.clear();
+        for (uint32_t i : active) {
+            ReadRequest r;
+            r.address = addr[i];
+            r.size    = sizeof(uint64_t);
+            r.dst     = &values[i];
+            batch.push_back(r);
+        }
+        mem.ReadBatch(batch.data(), batch.size());
+
+        size_t keep = 0;
+        for (size_t k = 0; k < active.size(); ++k) {
+            uint32_t i = active[k];
+            const auto& offs = result.paths[i].offsets;
+            if (!batch[k].ok || values[i] == 0) { addr[i] = 0; continue; }
+
+            addr[i] = static_cast<uintptr_t>(values[i]) + offs[depth];
+            if (depth + 1 < offs.size()) active[keep++] = i;
+        }
+        active.resize(keep);
+    }
+    return addr;
+}
+
+size_t FilterPointerPaths(MemorySource& mem, PointerScanResult& result,
+                          uintptr_t target, const std::vector<ModuleInfo>& live)
+{
+    auto addr = ResolvePointerPaths(mem, result, live);
+    size_t keep = 0;
+    for (size_t i = 0; i < result.paths.size(); ++i)
+        if (addr[i] == target)
+            result.paths[keep++] = std::move(result.paths[i]);
+    result.paths.resize(keep);
+    return keep;
+}
+
+void FormatPointerPath(const PointerScanResult& result, const PointerPath& path,
+                       std::string& out)
+{
+    // clear() + append rather than assign(): GCC 12's -Wrestrict trips
+    // over the inlined assign() of a short literal at -O2
+    out.clear();
+    out += path.module < result.modules.size()
+               ? std::string_view(result.modules[path.module])
+               : std::string_view("?");
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "+0x%X", path.moduleOffset);
+    out += buf;
+    for (int off : path.offsets) {
+        snprintf(buf, sizeof(buf), " -> 0x%X", off);
+        out += buf;
+    }
+}
+
+std::string FormatPointerPath(const PointerScanResult& result, const PointerPath& path)
+{
+    std::string s;
+    FormatPointerPath(result, path, s);
+    return s;
+}
+
+// =====================================================================
+//  On-disk format
+// =====================================================================
+//  u32 magic 'WPTR', u32 version
+//  varint moduleCount, { varint len, bytes }...
+//  varint pathCount, then per path (in canonical order):
+//      varint moduleDelta       (vs previous path)
+//      varint offset            (delta vs previous if same module)
+//      varint depth, zigzag varint offsets...
+
+static constexpr uint32_t kPtrMagic   = 0x52545057;   // "WPTR"
+static constexpr uint32_t kPtrVersion = 1;
+
+static void PutVarint(std::vector<uint8_t>& out, uint64_t v)
+{
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static bool GetVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint64_t ZigZag(int v)
+{
+    return (static_cast<uint64_t>(static_cast<int64_t>(v)) << 1) ^
+           static_cast<uint64_t>(static_cast<int64_t>(v) >> 63);
+}
+
+static int UnZigZag(uint64_t v)
+{
+    return static_cast<int>(static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1));
+}
+
+bool SavePointerPaths(const std::string& file, const PointerScanResult& result)
+{
+    PointerScanResult r = result;
+    Canonicalize(r);
+
+    std::vector<uint8_t> out;
+    for (uint32_t v : { kPtrMagic, kPtrVersion })
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+
+    PutVarint(out, r.modules.size());
+    for (const auto& name : r.modules) {
+        PutVarint(out, name.size());
+        out.insert(out.end(), name.begin(), name.end());
+    }
+
+    PutVarint(out, r.paths.size());
+    uint32_t prevModule = 0, prevOffset = 0;
+    for (const auto& p : r.paths) {
+        PutVarint(out, p.module - prevModule);
+        PutVarint(out, p.module == prevModule ? p.moduleOffset - prevOffset
+                                              : p.moduleOffset);
+        PutVarint(out, p.offsets.size());
+        for (int off : p.offsets) PutVarint(out, ZigZag(off));
+        prevModule = p.module;
+        prevOffset = p.moduleOffset;
+    }
+
+    std::ofstream f(file, std::ios::binary | std::ios::trunc);
+    if (!f) return false;
+    f.write(reinterpret_cast<const char*>(out.data()),
+            static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(f);
+}
+
+bool LoadPointerPaths(const std::string& file, PointerScanResult& out)
+{
+    std::ifstream f(file, std::ios::binary);
+    if (!f) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(f)),
+                              std::istreambuf_iterator<char>());
+
+    const uint8_t* p   = data.data();
+    const uint8_t* end = p + data.size();
+    if (data.size() < 8) return false;
+
+    auto u32 = [](const uint8_t* q) {
+        return uint32_t(q[0]) | uint32_t(q[1]) << 8 | uint32_t(q[2]) << 16 | uint32_t(q[3]) << 24;
+    };
+    if (u32(p) != kPtrMagic || u32(p + 4) != kPtrVersion) return false;
+    p += 8;
+
+    PointerScanResult r;
+    uint64_t moduleCount = 0;
+    if (!GetVarint(p, end, moduleCount) || moduleCount > data.size()) return false;
+    for (uint64_t i = 0; i < moduleCount; ++i) {
+        uint64_t len = 0;
+        if (!GetVarint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+        r.modules.emplace_back(reinterpret_cast<const char*>(p), static_cast<size_t>(len));
+        p += len;
+    }
+
+    uint64_t pathCount = 0;
+    if (!GetVarint(p, end, pathCount) || pathCount > data.size()) return false;
+    r.paths.reserve(static_cast<size_t>(pathCount));
+
+    uint32_t prevModule = 0, prevOffset = 0;
+    for (uint64_t i = 0; i < pathCount; ++i) {
+        uint64_t dm, off, depth;
+        if (!GetVarint(p, end, dm) || !GetVarint(p, end, off) ||
+            !GetVarint(p, end, depth) || depth > 64)
+            return false;
+
+        PointerPath path;
+        path.module       = prevModule + static_cast<uint32_t>(dm);
+        path.moduleOffset = static_cast<uint32_t>(dm == 0 ? prevOffset + off : off);
+        if (path.module >= r.modules.size()) return false;
+
+        for (uint64_t d = 0; d < depth; ++d) {
+            uint64_t z;
+            if (!GetVarint(p, end, z)) return false;
+            path.offsets.push_back(UnZigZag(z));
+        }
+        prevModule = path.module;
+        prevOffset = path.moduleOffset;
+        r.paths.push_back(std::move(path));
+    }
+
+    out = std::move(r);
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+PointerScanResult IntersectPointerPaths(const PointerScanResult& a,
+                                        const PointerScanResult& b)
+{
+    PointerScanResult ca = a, cb = b;
+    Canonicalize(ca);
+    Canonicalize(cb);
+
+    // Re-express b's paths in a's module numbering
+    std::unordered_map<std::string, uint32_t> index;
+    for (uint32_t i = 0; i < ca.modules.size(); ++i) index[ca.modules[i]] = i;
+
+    std::vector<PointerPath> bPaths;
+    bPaths.reserve(cb.paths.size());
+    for (auto& p : cb.paths) {
+        auto it = index.find(cb.modules[p.module]);
+        if (it == index.end()) continue;
+        p.module = it->second;
+        bPaths.push_back(std::move(p));
+    }
+    std::sort(bPaths.begin(), bPaths.end(), PathLess);
+
+    PointerScanResult r;
+    r.modules = ca.modules;
+    std::set_intersection(ca.paths.begin(), ca.paths.end(),
+                          bPaths.begin(), bPaths.end(),
+                          std::back_inserter(r.paths), PathLess);
+    Canonicalize(r);
+    return r;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "memory_source.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ── Pointer scan ─────────────────────────────────────────────────────
+// Finds static-base -> offset chains that end at a target address, in
+// the form EntityReader::SetChain() expects:
+//
+//     addr = base;  for (off : offsets) addr = *(uint64_t*)addr + off;
+//
+// PointerMap::Build reads all readable memory once (in parallel) and
+// keeps every aligned 8-byte slot whose value points into readable
+// memory, sorted by value.  FindPointerPaths then searches backwards
+// from the target one level at a time: every slot whose value is within
+// maxOffset below an address of the current level is a candidate link,
+// and a slot inside a loaded module image is a static base.
+//
+// Each slot is expanded at most once, at the first level it's reached
+// from (later, longer routes to it are dropped; this also breaks
+// cycles).  A slot reached from several addresses of the same level
+// keeps every link, so no path of minimal length is lost.  The search
+// stops early on the link budget, maxResults or a cancel request.
+//
+// Bases are stored module-relative (module name + offset) so results
+// stay valid across restarts and can be intersected between sessions.
+
+struct PointerPath {
+    uint32_t         module       = 0;   // index into PointerScanResult::modules
+    uint32_t         moduleOffset = 0;   // static slot = module base + this
+    std::vector<int> offsets;            // applied in order after each deref
+};
+
+struct PointerScanResult {
+    std::vector<std::string> modules;    // module names the paths refer to
+    std::vector<PointerPath> paths;      // sorted (module, offset, offsets)
+};
+
+struct PointerScanOptions {
+    int      maxDepth   = 5;             // max dereferences per path (>= 1)
+    int      maxOffset  = 0x1000;        // max offset added after a deref (>= 0)
+    size_t   maxResults = 100000;        // stop collecting after this many
+    size_t   maxLinks   = 1u << 22;      // candidate links examined, all levels
+    unsigned threads    = 0;             // 0 = one per hardware thread
+};
+
+// Live counters of a running search; `cancel` may be set from any
+// thread.  depth is 0 while the map is being built.
+struct PointerScanProgress {
+    std::atomic<bool>   cancel{ false };
+    std::atomic<int>    depth{ 0 };
+    std::atomic<size_t> links{ 0 };      // candidate links examined
+    std::atomic<size_t> paths{ 0 };      // static bases found so far
+    std::atomic<bool>   truncated{ false };  // budget / results / cancel hit
+};
+
+// =====================================================================
+//  PointerMap — reverse pointer map (value -> slots holding it)
+// =====================================================================
+class PointerMap {
+public:
+    // One parallel pass over the target's readable memory.  Setting
+    // `*cancel` stops it early (the map is then partial).
+    void Build(MemorySource& mem, unsigned threads = 0,
+               const std::atomic<bool>* cancel = nullptr);
+
+    void Clear();
+
+    size_t Size()    const { return entries.size(); }
+    double BuildMs() const { return buildMs; }
+
+    const std::vector<ModuleInfo>& Modules() const { return modules; }
+
+    struct Entry {
+        uintptr_t value;       // pointer stored in the slot
+        uintptr_t address;     // the slot itself
+    };
+
+    // Entries with lo <= value <= hi, as [first, last).
+    std::pair<const Entry*, const Entry*> Range(uintptr_t lo, uintptr_t hi) const;
+
+    // Index of the module containing `addr`, or -1.
+    int ModuleAt(uintptr_t addr) const;
+
+private:
+    std::vector<Entry>      entries;     // sorted by value
+    std::vector<ModuleInfo> modules;
+    double                  buildMs = 0;
+};
+
+// Chains from a static base to `target` (see the notes above).
+// Options out of range are clamped.
+PointerScanResult FindPointerPaths(const PointerMap& map, uintptr_t target,
+                                   const PointerScanOptions& opts = {},
+                                   PointerScanProgress* progress = nullptr);
+
+// =====================================================================
+//  PointerScanJob — map build + search on a worker thread
+// =====================================================================
+// For the UI: Start() returns at once, Progress() can be polled every
+// frame and Cancel() ends the search early with the paths found so far.
+// The map is owned by the job and only touched by the worker while
+// Running().
+class PointerScanJob {
+public:
+    PointerScanJob() = default;
+    ~PointerScanJob();
+
+    PointerScanJob(const PointerScanJob&) = delete;
+    PointerScanJob& operator=(const PointerScanJob&) = delete;
+
+    // `mem` must be safe to read from another thread (RegionMap, a
+    // platform source).  Returns false if a scan is still running.
+    bool Start(MemorySource& mem, uintptr_t target, const PointerScanOptions& opts);
+
+    void Cancel() { progress.cancel = true; }
+
+    // Cancel and wait for a running scan, then drop the map and result
+    // (before the source goes away).
+    void Reset();
+    bool Running() const { return running.load(std::memory_order_acquire); }
+
+    // Move out the result of a finished scan; false if there is none
+    // (still running, or already taken).
+    bool TakeResult(PointerScanResult& out);
+
+    const PointerScanProgress& Progress() const { return progress; }
+
+    // The last built map (empty while a scan is running).
+    const PointerMap& Map() const;
+
+private:
+    void Join();
+
+    std::thread         worker;
+    std::atomic<bool>   running{ false };
+    PointerScanProgress progress;
+    PointerMap          map;
+    PointerScanResult   result;
+    bool                hasResult = false;
+};
+
+// Absolute base address of `path` against a live module list
+// (matched by name).  Returns 0 if the module isn't loaded.
+uintptr_t ResolvePathBase(const PointerScanResult& result, const PointerPath& path,
+                          const std::vector<ModuleInfo>& live);
+
+// Follow every path in `result` and return the address each one ends
+// at (0 where a module is missing or a link is unreadable / null).
+// The paths are walked in lockstep, one ReadBatch per depth.
+std::vector<uintptr_t> ResolvePointerPaths(MemorySource& mem,
+                                           const PointerScanResult& result,
+                                           const std::vector<ModuleInfo>& live);
+
+// Keep only the paths that currently lead to `target`.
+size_t FilterPointerPaths(MemorySource& mem, PointerScanResult& result,
+                          uintptr_t target, const std::vector<ModuleInfo>& live);
+
+// Human-readable "jvm.dll+0x1234 -> 0x10 -> 0x48".
+std::string FormatPointerPath(const PointerScanResult& result, const PointerPath& path);
+
+// Same, into `out` (reuses its capacity; for per-frame labels).
+void FormatPointerPath(const PointerScanResult& result, const PointerPath& path,
+                       std::string& out);
+
+// ── On-disk format ───────────────────────────────────────────────────
+// Header + module name table + paths sorted and delta/varint encoded
+// (typically 4-8 bytes per path).
+bool SavePointerPaths(const std::string& file, const PointerScanResult& result);
+bool LoadPointerPaths(const std::string& file, PointerScanResult& out);
+
+// Paths present in both results (same module name, offset and chain).
+PointerScanResult IntersectPointerPaths(const PointerScanResult& a,
+                                        const PointerScanResult& b);
@@ -0,0 +1,194 @@
+#include "read_cache.h"
+
+#include <algorithm>
+#include <bit>
+
+// Slots probed for a page before the home slot is evicted.
+static constexpr size_t kProbe = 8;
+
+CachedMemorySource::CachedMemorySource(size_t maxPages)
+{
+    size_t n = std::bit_ceil(std::max<size_t>(maxPages, kProbe));
+    mask = n - 1;
+    slots.resize(n);
+    data.resize(n * kPageSize);
+}
+
+CachedMemorySource::CachedMemorySource(MemorySource& inner, size_t maxPages)
+    : CachedMemorySource(maxPages)
+{
+    this->inner = &inner;
+}
+
+CachedMemorySource::Stats CachedMemorySource::GetStats() const
+{
+    Stats s;
+    s.hits     = hits.load(std::memory_order_relaxed);
+    s.misses   = misses.load(std::memory_order_relaxed);
+    s.bypassed = bypassed.load(std::memory_order_relaxed);
+    return s;
+}
+
+void CachedMemorySource::ResetStats()
+{
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+    bypassed.store(0, std::memory_order_relaxed);
+}
+
+size_t CachedMemorySource::Home(uintptr_t page) const
+{
+    // Fibonacci hash of the page number
+    uint64_t h = static_cast<uint64_t>(page / kPageSize) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) & mask;
+}
+
+// Within one generation slots are only ever filled, never emptied, and
+// a page is inserted at the first stale slot of its probe window.  So
+// the first stale slot seen while probing ends the search.
+const uint8_t* CachedMemorySource::Lookup(uintptr_t page, uint32_t& valid)
+{
+    size_t idx = Home(page);
+    for (size_t i = 0; i < kProbe; ++i, idx = (idx + 1) & mask) {
+        const Slot& s = slots[idx];
+        if (s.gen != generation) return nullptr;
+        if (s.page == page) {
+            valid = s.valid;
+            return data.data() + idx * kPageSize;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* CachedMemorySource::Fetch(uintptr_t page, uint32_t& valid)
+{
+    size_t home = Home(page);
+    size_t idx  = home;
+    for (size_t i = 0; i < kProbe; ++i, idx = (idx + 1) & mask)
+        if (slots[idx].gen != generation) break;
+    if (slots[idx].gen == generation)
+        idx = home;                         // window full: evict
+
+    uint8_t* buf = data.data() + idx * kPageSize;
+    Slot& s = slots[idx];
+    s.page  = page;
+    s.gen   = generation;
+    s.valid = static_cast<uint32_t>(inner->Read(page, buf, kPageSize));
+    misses.fetch_add(1, std::memory_order_relaxed);
+
+    valid = s.valid;
+    return buf;
+}
+
+ptrdiff_t CachedMemorySource::Reserve(uintptr_t page)
+{
+    size_t idx = Home(page);
+    for (size_t i = 0; i < kProbe; ++i, idx = (idx + 1) & mask) {
+        Slot& s = slots[idx];
+        if (s.gen == generation) continue;
+        s.page  = page;
+        s.gen   = generation;
+        s.valid = 0;
+        return static_cast<ptrdiff_t>(idx);
+    }
+    return -1;
+}
+
+size_t CachedMemorySource::Read(uintptr_t addr, void* dst, size_t size)
+{
+    if (!inner || size == 0) return 0;
+
+    if (size > kBypassBytes) {
+        bypassed.fetch_add(1, std::memory_order_relaxed);
+        return inner->Read(addr, dst, size);
+    }
+
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t done = 0;
+
+    while (done < size) {
+        uintptr_t cur  = addr + done;
+        uintptr_t page = cur & ~static_cast<uintptr_t>(kPageSize - 1);
+        size_t    off  = static_cast<size_t>(cur - page);
+        size_t    n    = std::min(size - done, kPageSize - off);
+
+        uint32_t valid = 0;
+        const uint8_t* src = Lookup(page, valid);
+        if (src)
+            hits.fetch_add(1, std::memory_order_relaxed);
+        else
+            src = Fetch(page, valid);
+
+        if (off + n > valid) {
+            // The page isn't readable from its start (a snapshot region
+            // beginning mid-page) or ends early: ask the inner source
+            // for the rest directly so prefix semantics are kept.
+            bypassed.fetch_add(1, std::memory_order_relaxed);
+            return done + inner->Read(cur, out + done, size - done);
+        }
+
+        std::memcpy(out + done, src + off, n);
+        done += n;
+    }
+    return done;
+}
+
+std::vector<MemoryRegion> CachedMemorySource::Regions()
+{
+    return inner ? inner->Regions() : std::vector<MemoryRegion>{};
+}
+
+std::vector<ModuleInfo> CachedMemorySource::Modules()
+{
+    return inner ? inner->Modules() : std::vector<ModuleInfo>{};
+}
+
+size_t CachedMemorySource::ReadBatch(ReadRequest* reqs, size_t count)
+{
+    if (!inner) {
+        for (size_t i = 0; i < count; ++i) reqs[i].ok = false;
+        return 0;
+    }
+
+    // 1. One page request per missing page
+    pageReqs.clear();
+    pageSlots.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (reqs[i].size == 0 || reqs[i].size > kBypassBytes) continue;
+
+        uintptr_t first = reqs[i].address & ~static_cast<uintptr_t>(kPageSize - 1);
+        uintptr_t last  = (reqs[i].address + reqs[i].size - 1)
+                        & ~static_cast<uintptr_t>(kPageSize - 1);
+        for (uintptr_t page = first; page <= last; page += kPageSize) {
+            uint32_t valid;
+            if (Lookup(page, valid)) continue;
+
+            ptrdiff_t slot = Reserve(page);
+            if (slot < 0) continue;
+
+            ReadRequest pr;
+            pr.address = page;
+            pr.size    = kPageSize;
+            pr.dst     = data.data() + static_cast<size_t>(slot) * kPageSize;
+            pageReqs.push_back(pr);
+            pageSlots.push_back(static_cast<size_t>(slot));
+        }
+    }
+
+    // 2. Fetch them together.  A failed page keeps valid = 0, so reads
+    //    touching it fall back to a direct Read() (for the prefix).
+    if (!pageReqs.empty()) {
+        inner->ReadBatch(pageReqs.data(), pageReqs.size());
+        misses.fetch_add(pageReqs.size(), std::memory_order_relaxed);
+        for (size_t k = 0; k < pageReqs.size(); ++k)
+            if (pageReqs[k].ok) slots[pageSlots[k]].valid = kPageSize;
+    }
+
+    // 3. Serve every request from the now-warm pages
+    size_t ok = 0;
+    for (size_t i = 0; i < count; ++i) {
+        reqs[i].ok = Read(reqs[i].address, reqs[i].dst, reqs[i].size) == reqs[i].size;
+        ok += reqs[i].ok;
+    }
+    return ok;
+}
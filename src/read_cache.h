@@ -0,0 +1,89 @@
+#pragma once
+
+#include "memory_source.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// ── Page-granular read cache ─────────────────────────────────────────
+// A read-through cache in front of another MemorySource.  Reads are
+// served from local copies of whole 4 KB pages; each distinct page is
+// fetched from the inner source at most once per generation.
+//
+// Call NewGeneration() once per tick / frame: it invalidates every page
+// in O(1) so values are never older than the current tick.  Within a
+// tick, typed reads of the same object (position doubles, Box fields,
+// a re-read panel address) cost one syscall per page instead of one each.
+//
+// The table is fixed-size (open addressing, no allocation after
+// construction); when a tick touches more pages than fit, the oldest
+// slot in the probe window is replaced.  Reads larger than
+// kBypassBytes go straight to the inner source.
+//
+// Unlike the platform sources a cache is not safe for concurrent
+// Read(); give each thread its own.  The counters may be read from any
+// thread.
+class CachedMemorySource final : public MemorySource {
+public:
+    static constexpr size_t kPageSize    = 4096;
+    static constexpr size_t kBypassBytes = 4 * kPageSize;
+
+    struct Stats {
+        uint64_t hits     = 0;    // page lookups served locally
+        uint64_t misses   = 0;    // page fetches from the inner source
+        uint64_t bypassed = 0;    // reads passed through uncached
+    };
+
+    // `maxPages` is rounded up to a power of two.
+    explicit CachedMemorySource(size_t maxPages = 1024);
+    CachedMemorySource(MemorySource& inner, size_t maxPages = 1024);
+
+    void Attach(MemorySource* source) { inner = source; NewGeneration(); }
+    MemorySource* Inner() const       { return inner; }
+
+    // Drop every cached page.
+    void NewGeneration() { ++generation; }
+    uint64_t Generation() const { return generation; }
+
+    Stats GetStats() const;
+    void  ResetStats();
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override;
+
+    // Fetches every page the requests touch that isn't cached yet in a
+    // single inner ReadBatch, then serves the requests locally.  Pages
+    // that don't fit this generation's table are left to Read().
+    size_t ReadBatch(ReadRequest* reqs, size_t count) override;
+
+    std::vector<MemoryRegion> Regions() override;
+    std::vector<ModuleInfo>   Modules() override;
+    bool Valid() const override { return inner && inner->Valid(); }
+
+private:
+    struct Slot {
+        uintptr_t page  = 0;
+        uint64_t  gen   = 0;      // generation it was filled in; 0 = never
+        uint32_t  valid = 0;      // readable prefix of the page
+    };
+
+    // Page for `page` filled in the current generation, or nullptr.
+    const uint8_t* Lookup(uintptr_t page, uint32_t& valid);
+    const uint8_t* Fetch(uintptr_t page, uint32_t& valid);
+    // Claim a free slot for `page` without evicting, or -1.
+    ptrdiff_t Reserve(uintptr_t page);
+    size_t Home(uintptr_t page) const;
+
+    MemorySource*        inner = nullptr;
+    uint64_t             generation = 1;
+    size_t               mask = 0;
+    std::vector<Slot>    slots;
+    std::vector<uint8_t> data;          // slots.size() * kPageSize
+
+    std::vector<ReadRequest> pageReqs;  // ReadBatch scratch
+    std::vector<size_t>      pageSlots;
+
+    std::atomic<uint64_t> hits{ 0 };
+    std::atomic<uint64_t> misses{ 0 };
+    std::atomic<uint64_t> bypassed{ 0 };
+};
@@ -0,0 +1,159 @@
+#include "region_map.h"
+
+#include <algorithm>
+#include <chrono>
+
+RegionMap::~RegionMap()
+{
+    StopAutoRefresh();
+}
+
+// =====================================================================
+//  Refresh
+// =====================================================================
+
+size_t RegionMap::Refresh()
+{
+    std::lock_guard<std::mutex> lk(refreshMtx);
+    auto t0 = std::chrono::steady_clock::now();
+
+    auto snap = std::make_shared<Snapshot>();
+    snap->regions = inner.Regions();
+    std::sort(snap->regions.begin(), snap->regions.end(),
+              [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+
+    for (const auto& r : snap->regions) {
+        if (r.size == 0) continue;
+        if (!snap->spans.empty() && snap->spans.back().end >= r.base)
+            snap->spans.back().end = std::max(snap->spans.back().end, r.base + r.size);
+        else
+            snap->spans.push_back({ r.base, r.base + r.size });
+    }
+
+    auto prev = current.load();
+    snap->version   = prev ? prev->version + 1 : 1;
+    snap->refreshMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    size_t n = snap->regions.size();
+    current.store(std::move(snap));
+    return n;
+}
+
+void RegionMap::StartAutoRefresh(int intervalMs)
+{
+    StopAutoRefresh();
+    Refresh();
+
+    refresherStop = false;
+    refresher = std::thread([this, intervalMs] {
+        std::unique_lock<std::mutex> lk(refresherMtx);
+        while (!refresherCv.wait_for(lk, std::chrono::milliseconds(intervalMs),
+                                     [this] { return refresherStop; })) {
+            lk.unlock();
+            Refresh();
+            lk.lock();
+        }
+    });
+}
+
+void RegionMap::StopAutoRefresh()
+{
+    {
+        std::lock_guard<std::mutex> lk(refresherMtx);
+        refresherStop = true;
+    }
+    refresherCv.notify_all();
+    if (refresher.joinable())
+        refresher.join();
+}
+
+// =====================================================================
+//  Lookups
+// =====================================================================
+
+size_t RegionMap::Readable(const Snapshot& s, uintptr_t addr, size_t len)
+{
+    auto it = std::upper_bound(s.spans.begin(), s.spans.end(), addr,
+        [](uintptr_t a, const Span& sp) { return a < sp.begin; });
+    if (it == s.spans.begin()) return 0;
+    --it;
+    if (addr >= it->end) return 0;
+    return std::min(len, static_cast<size_t>(it->end - addr));
+}
+
+bool RegionMap::IsReadable(uintptr_t addr, size_t len) const
+{
+    return ReadableLength(addr, len) == len;
+}
+
+size_t RegionMap::ReadableLength(uintptr_t addr, size_t len) const
+{
+    auto snap = current.load();
+    return snap ? Readable(*snap, addr, len) : len;
+}
+
+RegionMap::Stats RegionMap::GetStats() const
+{
+    Stats st;
+    if (auto snap = current.load()) {
+        st.regions   = snap->regions.size();
+        st.version   = snap->version;
+        st.refreshMs = snap->refreshMs;
+    }
+    st.rejected = rejected.load(std::memory_order_relaxed);
+    return st;
+}
+
+// =====================================================================
+//  MemorySource
+// =====================================================================
+
+size_t RegionMap::Read(uintptr_t addr, void* dst, size_t size)
+{
+    size_t n = ReadableLength(addr, size);
+    if (n == 0) {
+        if (size) rejected.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    return inner.Read(addr, dst, n);
+}
+
+size_t RegionMap::ReadBatch(ReadRequest* reqs, size_t count)
+{
+    auto snap = current.load();
+    if (!snap) return inner.ReadBatch(reqs, count);
+
+    // Forward only the requests that can succeed
+    thread_local std::vector<ReadRequest> pass;
+    thread_local std::vector<size_t>      index;
+    pass.clear();
+    index.clear();
+
+    uint64_t refused = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (Readable(*snap, reqs[i].address, reqs[i].size) == reqs[i].size) {
+            pass.push_back(reqs[i]);
+            index.push_back(i);
+        } else {
+            reqs[i].ok = false;
+            ++refused;
+        }
+    }
+    if (refused) rejected.fetch_add(refused, std::memory_order_relaxed);
+
+    size_t ok = pass.empty() ? 0 : inner.ReadBatch(pass.data(), pass.size());
+    for (size_t k = 0; k < pass.size(); ++k)
+        reqs[index[k]].ok = pass[k].ok;
+    return ok;
+}
+
+std::vector<MemoryRegion> RegionMap::Regions()
+{
+    auto snap = current.load();
+    if (!snap) {
+        Refresh();
+        snap = current.load();
+    }
+    return snap->regions;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "memory_source.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ── Cached region map ────────────────────────────────────────────────
+// A MemorySource in front of another one that remembers the target's
+// region list instead of re-walking the address space (VirtualQueryEx,
+// /proc/<pid>/maps) for every scan.
+//
+// The regions are kept as a sorted interval list with adjacent regions
+// merged, so IsReadable(addr, len) is one binary search.  Reads are
+// checked against it first: a garbage oop or a stale offset costs a
+// lookup, not a failing kernel call.  Reads that run off the end of a
+// mapped span are trimmed to the readable prefix before they're issued.
+//
+// The snapshot is refreshed on demand (Refresh()) or by a background
+// thread (StartAutoRefresh()).  Memory committed since the last refresh
+// reads as unmapped until the next one.  Before the first refresh
+// every read is passed through unchecked.
+//
+// Snapshots are immutable and published by pointer swap, so lookups
+// from any number of threads never wait on a refresh.
+class RegionMap final : public MemorySource {
+public:
+    explicit RegionMap(MemorySource& inner) : inner(inner) {}
+    ~RegionMap() override;
+
+    RegionMap(const RegionMap&) = delete;
+    RegionMap& operator=(const RegionMap&) = delete;
+
+    // Re-query the inner source and publish a new snapshot.
+    // Returns the number of regions.
+    size_t Refresh();
+
+    // Refresh every `intervalMs` on a background thread.
+    void StartAutoRefresh(int intervalMs = 1000);
+    void StopAutoRefresh();
+
+    // True if all of [addr, addr + len) is mapped and readable
+    // (adjacent regions count as one span).  True for anything before
+    // the first Refresh().
+    bool IsReadable(uintptr_t addr, size_t len) const;
+
+    // Number of readable bytes starting at `addr` (up to `len`).
+    size_t ReadableLength(uintptr_t addr, size_t len) const;
+
+    struct Stats {
+        size_t   regions   = 0;
+        uint64_t version   = 0;     // bumped by every refresh
+        double   refreshMs = 0;     // time the last refresh took
+        uint64_t rejected  = 0;     // reads refused without a kernel call
+    };
+    Stats GetStats() const;
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override;
+    size_t ReadBatch(ReadRequest* reqs, size_t count) override;
+
+    // From the snapshot (refreshing first if there is none yet).
+    std::vector<MemoryRegion> Regions() override;
+    std::vector<ModuleInfo>   Modules() override { return inner.Modules(); }
+    bool Valid() const override { return inner.Valid(); }
+
+private:
+    struct Span {
+        uintptr_t begin;
+        uintptr_t end;
+    };
+    struct Snapshot {
+        std::vector<MemoryRegion> regions;  // as reported, sorted by base
+        std::vector<Span>         spans;    // merged, sorted
+        uint64_t                  version   = 0;
+        double                    refreshMs = 0;
+    };
+
+    static size_t Readable(const Snapshot& s, uintptr_t addr, size_t len);
+
+    MemorySource& inner;
+    std::atomic<std::shared_ptr<const Snapshot>> current;
+    std::mutex               refreshMtx;    // serializes Refresh()
+    std::atomic<uint64_t>    rejected{ 0 };
+
+    std::thread              refresher;
+    std::mutex               refresherMtx;
+    std::condition_variable  refresherCv;
+    bool                     refresherStop = false;
+};
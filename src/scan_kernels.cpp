@@ -0,0 +1,311 @@
+#include "scan_kernels.h"
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define WD42_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang only emit AVX2 instructions inside functions that opt in;
+// MSVC accepts the intrinsics anywhere.
+#if defined(WD42_X86) && (defined(__GNUC__) || defined(__clang__))
+#define WD42_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WD42_TARGET_AVX2
+#endif
+
+// ─────────────────────────────────────────────────────────────────────
+CompiledPattern CompilePattern(const PatternView& pattern)
+{
+    CompiledPattern cp;
+    cp.length = pattern.length;
+
+    size_t padded = (cp.length + 31) & ~static_cast<size_t>(31);
+    cp.bytes.assign(padded, 0x00);
+    cp.mask.assign(padded, 0x00);
+
+    int bestCost = 1 << 30;
+    for (size_t i = 0; i < cp.length; ++i) {
+        if (!pattern.mask[i]) continue;
+        cp.bytes[i] = pattern.bytes[i];
+        cp.mask[i]  = 0xFF;
+
+        int cost = pattern_detail::ByteCommonness(pattern.bytes[i]);
+        if (!cp.hasExact || cost < bestCost) {
+            bestCost  = cost;
+            cp.anchor = i;
+        }
+        cp.hasExact = true;
+    }
+
+    // Second anchor: the exact byte farthest from the first one, so the
+    // two compares test independent parts of the pattern.
+    cp.anchor2 = cp.anchor;
+    size_t bestDist = 0;
+    for (size_t i = 0; i < cp.length; ++i) {
+        if (!cp.mask[i]) continue;
+        size_t dist = (i > cp.anchor) ? i - cp.anchor : cp.anchor - i;
+        if (dist > bestDist) {
+            bestDist   = dist;
+            cp.anchor2 = i;
+        }
+    }
+
+    return cp;
+}
+
+// =====================================================================
+//  Scalar reference
+// =====================================================================
+
+static bool VerifyScalar(const uint8_t* p, const CompiledPattern& pat)
+{
+    for (size_t j = 0; j < pat.length; ++j) {
+        if (pat.mask[j] && p[j] != pat.bytes[j])
+            return false;
+    }
+    return true;
+}
+
+// `cap` is the out.size() at which to stop (early-exit scans).
+static void FindScalar(const uint8_t* buf, size_t size, size_t from,
+                       const CompiledPattern& pat, std::vector<size_t>& out,
+                       size_t cap)
+{
+    if (size < pat.length) return;
+    size_t limit = size - pat.length;
+
+    for (size_t i = from; i <= limit && out.size() < cap; ++i) {
+        if (VerifyScalar(buf + i, pat))
+            out.push_back(i);
+    }
+}
+
+#if defined(WD42_X86)
+
+static inline unsigned LowestBit(unsigned v)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, v);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+// =====================================================================
+//  SSE2 (baseline on every x64 CPU)
+// =====================================================================
+
+static bool VerifySSE2(const uint8_t* p, const CompiledPattern& pat,
+                       size_t wide)
+{
+    const __m128i zero = _mm_setzero_si128();
+    for (size_t k = 0; k < wide; k += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pat.bytes.data() + k));
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pat.mask.data() + k));
+        __m128i diff = _mm_and_si128(_mm_xor_si128(d, b), m);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) != 0xFFFF)
+            return false;
+    }
+    return true;
+}
+
+static void FindSSE2(const uint8_t* buf, size_t size,
+                     const CompiledPattern& pat, std::vector<size_t>& out,
+                     size_t cap)
+{
+    if (size < pat.length) return;
+
+    const size_t last  = size - pat.length;
+    const size_t reach = std::max(pat.anchor, pat.anchor2) + 16;
+    const size_t wide  = (pat.length + 15) & ~static_cast<size_t>(15);
+
+    const __m128i a1 = _mm_set1_epi8(static_cast<char>(pat.bytes[pat.anchor]));
+    const __m128i a2 = _mm_set1_epi8(static_cast<char>(pat.bytes[pat.anchor2]));
+
+    size_t i = 0;
+    if (size >= reach) {
+        const size_t vecEnd = size - reach;
+        for (; i <= vecEnd && i <= last; i += 16) {
+            __m128i c1 = _mm_cmpeq_epi8(a1, _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(buf + i + pat.anchor)));
+            __m128i c2 = _mm_cmpeq_epi8(a2, _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(buf + i + pat.anchor2)));
+            unsigned bits = static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_and_si128(c1, c2)));
+
+            while (bits) {
+                size_t pos = i + LowestBit(bits);
+                if (pos > last) break;
+
+                bool match = (pos + wide <= size)
+                    ? VerifySSE2(buf + pos, pat, wide)
+                    : VerifyScalar(buf + pos, pat);
+                if (match) {
+                    out.push_back(pos);
+                    if (out.size() >= cap) return;
+                }
+
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // Remaining starts whose anchor loads would run past the buffer
+    FindScalar(buf, size, i, pat, out, cap);
+}
+
+// =====================================================================
+//  AVX2
+// =====================================================================
+
+WD42_TARGET_AVX2
+static bool VerifyAVX2(const uint8_t* p, const CompiledPattern& pat,
+                       size_t wide)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t k = 0; k < wide; k += 32) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pat.bytes.data() + k));
+        __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pat.mask.data() + k));
+        __m256i diff = _mm256_and_si256(_mm256_xor_si256(d, b), m);
+        if (static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(diff, zero))) != 0xFFFFFFFFu)
+            return false;
+    }
+    return true;
+}
+
+WD42_TARGET_AVX2
+static void FindAVX2(const uint8_t* buf, size_t size,
+                     const CompiledPattern& pat, std::vector<size_t>& out,
+                     size_t cap)
+{
+    if (size < pat.length) return;
+
+    const size_t last  = size - pat.length;
+    const size_t reach = std::max(pat.anchor, pat.anchor2) + 32;
+    const size_t wide  = (pat.length + 31) & ~static_cast<size_t>(31);
+
+    const __m256i a1 = _mm256_set1_epi8(static_cast<char>(pat.bytes[pat.anchor]));
+    const __m256i a2 = _mm256_set1_epi8(static_cast<char>(pat.bytes[pat.anchor2]));
+
+    size_t i = 0;
+    if (size >= reach) {
+        const size_t vecEnd = size - reach;
+        for (; i <= vecEnd && i <= last; i += 32) {
+            __m256i c1 = _mm256_cmpeq_epi8(a1, _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(buf + i + pat.anchor)));
+            __m256i c2 = _mm256_cmpeq_epi8(a2, _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(buf + i + pat.anchor2)));
+            unsigned bits = static_cast<unsigned>(
+                _mm256_movemask_epi8(_mm256_and_si256(c1, c2)));
+
+            while (bits) {
+                size_t pos = i + LowestBit(bits);
+                if (pos > last) break;
+
+                bool match = (pos + wide <= size)
+                    ? VerifyAVX2(buf + pos, pat, wide)
+                    : VerifyScalar(buf + pos, pat);
+                if (match) {
+                    out.push_back(pos);
+                    if (out.size() >= cap) return;
+                }
+
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    FindScalar(buf, size, i, pat, out, cap);
+}
+
+// ── CPU feature detection ────────────────────────────────────────────
+static bool CpuHasAVX2()
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+
+    // AVX needs OS support for saving YMM state (OSXSAVE + XCR0 bits)
+    __cpuid(r, 1);
+    bool osxsave = (r[2] & (1 << 27)) != 0;
+    bool avx     = (r[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // WD42_X86
+
+// =====================================================================
+//  Dispatch
+// =====================================================================
+
+ScanKernel BestScanKernel()
+{
+#if defined(WD42_X86)
+    static const ScanKernel best =
+        CpuHasAVX2() ? ScanKernel::AVX2 : ScanKernel::SSE2;
+    return best;
+#else
+    return ScanKernel::Scalar;
+#endif
+}
+
+const char* ScanKernelName(ScanKernel kernel)
+{
+    switch (kernel) {
+    case ScanKernel::Scalar: return "scalar";
+    case ScanKernel::SSE2:   return "SSE2";
+    case ScanKernel::AVX2:   return "AVX2";
+    }
+    return "?";
+}
+
+void FindMatchesWith(ScanKernel kernel,
+                     const uint8_t* buf, size_t size,
+                     const CompiledPattern& pat, std::vector<size_t>& out,
+                     size_t maxHits)
+{
+    if (pat.length == 0 || maxHits == 0) return;
+    size_t cap = (maxHits > SIZE_MAX - out.size()) ? SIZE_MAX : out.size() + maxHits;
+
+    // All-wildcard patterns match everywhere; nothing to anchor on.
+    if (!pat.hasExact) kernel = ScanKernel::Scalar;
+
+#if defined(WD42_X86)
+    if (kernel == ScanKernel::AVX2 && BestScanKernel() != ScanKernel::AVX2)
+        kernel = ScanKernel::SSE2;
+
+    switch (kernel) {
+    case ScanKernel::AVX2: FindAVX2(buf, size, pat, out, cap); return;
+    case ScanKernel::SSE2: FindSSE2(buf, size, pat, out, cap); return;
+    default: break;
+    }
+#endif
+
+    FindScalar(buf, size, 0, pat, out, cap);
+}
+
+void FindMatches(const uint8_t* buf, size_t size,
+                 const CompiledPattern& pat, std::vector<size_t>& out,
+                 size_t maxHits)
+{
+    FindMatchesWith(BestScanKernel(), buf, size, pat, out, maxHits);
+}
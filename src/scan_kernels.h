@@ -0,0 +1,56 @@
+#pragma once
+
+#include "pattern.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ── Wildcard match kernels ───────────────────────────────────────────
+// Low-level matchers used by the AOB scanner.  They work on a local
+// buffer only (no process access), so they can be benchmarked and
+// compared against each other off the target machine.
+//
+// The vector kernels locate candidates with two anchor bytes (the
+// rarest exact byte in the pattern plus the exact byte farthest from
+// it), then verify the full masked compare 16/32 bytes at a time.
+// Every kernel reports exactly the same offsets as the scalar one.
+
+enum class ScanKernel {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+// Pattern prepared for the kernels.  `bytes`/`mask` are zero-padded to
+// a multiple of 32 so the wide verify never needs a tail case.
+struct CompiledPattern {
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;     // 0xFF = must match, 0x00 = wildcard
+    size_t length  = 0;            // unpadded pattern length
+    size_t anchor  = 0;            // offset of the rarest exact byte
+    size_t anchor2 = 0;            // second exact byte used to filter
+    bool   hasExact = false;       // false = pattern is all wildcards
+};
+
+CompiledPattern CompilePattern(const PatternView& pattern);
+
+// Best kernel supported by this CPU (AVX2 > SSE2 > Scalar).
+// Detected once and cached.
+ScanKernel BestScanKernel();
+
+const char* ScanKernelName(ScanKernel kernel);
+
+// Append the offset of every match in `buf[0..size)` to `out`, in
+// ascending order, stopping after `maxHits` matches.
+// Uses BestScanKernel().
+void FindMatches(const uint8_t* buf, size_t size,
+                 const CompiledPattern& pat, std::vector<size_t>& out,
+                 size_t maxHits = SIZE_MAX);
+
+// Same, with an explicit kernel.  Falls back to Scalar if the CPU
+// lacks support for the requested one.
+void FindMatchesWith(ScanKernel kernel,
+                     const uint8_t* buf, size_t size,
+                     const CompiledPattern& pat, std::vector<size_t>& out,
+                     size_t maxHits = SIZE_MAX);
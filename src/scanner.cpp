@@ -1,139 +1,780 @@
 #include "scanner.h"
+#include "scan_kernels.h"
+#include "multi_pattern.h"
 
-#include <sstream>
 #include <iostream>
 #include <algorithm>
-
-// ─────────────────────────────────────────────────────────────────────
-ParsedPattern ParsePattern(const std::string& pattern)
-{
-    ParsedPattern p;
-    std::istringstream ss(pattern);
-    std::string token;
-
-    while (ss >> token) {
-        if (token == "?" || token == "??") {
-            p.bytes.push_back(0x00);
-            p.mask.push_back(false);
-        } else {
-            p.bytes.push_back(
-                static_cast<uint8_t>(std::stoul(token, nullptr, 16)));
-            p.mask.push_back(true);
-        }
-    }
-    return p;
-}
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 
 // ── Internal: scan a local buffer for the pattern ────────────────────
+// Thin adapter over the vectorized kernels in scan_kernels.cpp.
 static void ScanBuffer(const uint8_t* buf, size_t bufSize,
                        uintptr_t baseAddr,
-                       const ParsedPattern& pat,
+                       const CompiledPattern& pat,
                        std::vector<ScanResult>& results)
 {
-    if (bufSize < pat.bytes.size()) return;
+    thread_local std::vector<size_t> offsets;
+    offsets.clear();
 
-    size_t patLen = pat.bytes.size();
-    size_t limit  = bufSize - patLen;
+    FindMatches(buf, bufSize, pat, offsets);
 
-    for (size_t i = 0; i <= limit; ++i) {
-        bool match = true;
-        for (size_t j = 0; j < patLen; ++j) {
-            if (pat.mask[j] && buf[i + j] != pat.bytes[j]) {
-                match = false;
-                break;
-            }
+    for (size_t off : offsets)
+        results.push_back({ baseAddr + off });
+}
+
+static constexpr size_t kPageSize = 4096;
+
+// ── Internal: split regions into overlapping work items ──────────────
+// Each chunk owns match starts in [base, base + span) and reads `overlap`
+// extra bytes past that (clamped to the region) so a match straddling
+// the cut is still seen, exactly once, by the chunk it starts in.
+struct ScanChunk {
+    uintptr_t base     = 0;
+    size_t    span     = 0;
+    size_t    readSize = 0;
+};
+
+static std::vector<ScanChunk> SplitIntoChunks(const std::vector<ScanRegion>& regions,
+                                              size_t chunkSize, size_t overlap)
+{
+    // Keep chunk (and so window) starts page aligned
+    chunkSize = std::max<size_t>(kPageSize, chunkSize & ~(kPageSize - 1));
+
+    std::vector<ScanChunk> chunks;
+    for (const auto& r : regions) {
+        for (size_t off = 0; off < r.size; off += chunkSize) {
+            ScanChunk c;
+            c.base     = r.base + off;
+            c.span     = std::min(chunkSize, r.size - off);
+            c.readSize = std::min(c.span + overlap, r.size - off);
+            chunks.push_back(c);
+        }
+    }
+    return chunks;
+}
+
+// ── Internal: worker count + window size from the memory budget ──────
+// Every worker holds two windows (double buffering), so the read
+// buffers of a whole scan never exceed `memoryBudget` (plus the small
+// per-window overlap).
+static constexpr size_t kMinWindow = 64u << 10;
+static constexpr size_t kMaxWindow = 4u << 20;
+
+struct ScanPlan {
+    unsigned threads = 1;
+    size_t   window  = kMinWindow;
+};
+
+static ScanPlan MakeScanPlan(const ScanOptions& opts, size_t workItems)
+{
+    ScanPlan plan;
+
+    unsigned n = opts.threads;
+    if (n == 0) n = std::max(1u, std::thread::hardware_concurrency());
+    if (n > workItems) n = static_cast<unsigned>(std::max<size_t>(1, workItems));
+
+    size_t maxByBudget = std::max<size_t>(1, opts.memoryBudget / (2 * kMinWindow));
+    if (n > maxByBudget) n = static_cast<unsigned>(maxByBudget);
+
+    plan.threads = n;
+    plan.window  = std::clamp(opts.memoryBudget / (2 * static_cast<size_t>(n)),
+                              kMinWindow, kMaxWindow) & ~(kPageSize - 1);
+    return plan;
+}
+
+// ── Internal: one worker's read-ahead thread ─────────────────────────
+// Started once per worker for a whole scan and parked on a condition
+// variable between windows, so reading ahead costs a hand-off per
+// window instead of a thread.  One read is in flight at a time: Post()
+// it, then Wait() for its byte count before posting the next.
+class WindowPrefetcher {
+public:
+    explicit WindowPrefetcher(MemorySource& mem)
+        : mem(mem), thread(&WindowPrefetcher::Loop, this) {}
+
+    ~WindowPrefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    WindowPrefetcher(const WindowPrefetcher&) = delete;
+    WindowPrefetcher& operator=(const WindowPrefetcher&) = delete;
+
+    void Post(uint8_t* dst, uintptr_t addr, size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            reqDst  = dst;
+            reqAddr = addr;
+            reqSize = size;
+            pending = true;
         }
-        if (match) {
-            results.push_back({ baseAddr + i });
+        cv.notify_all();
+    }
+
+    // A read that runs into an unreadable page still returns the
+    // prefix that arrived; keep it.
+    size_t Wait()
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        cv.wait(lk, [this] { return !pending; });
+        return got;
+    }
+
+private:
+    void Loop()
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        for (;;) {
+            cv.wait(lk, [this] { return stopping || pending; });
+            if (stopping) return;
+
+            uint8_t*  dst  = reqDst;
+            uintptr_t addr = reqAddr;
+            size_t    size = reqSize;
+            lk.unlock();
+            size_t n = mem.Read(addr, dst, size);
+            lk.lock();
+
+            got     = n;
+            pending = false;
+            cv.notify_all();
+        }
+    }
+
+    MemorySource&           mem;
+    std::mutex              mtx;
+    std::condition_variable cv;
+    uint8_t*                reqDst   = nullptr;    // posted read, under mtx
+    uintptr_t               reqAddr  = 0;
+    size_t                  reqSize  = 0;
+    size_t                  got      = 0;
+    bool                    pending  = false;
+    bool                    stopping = false;
+    std::thread             thread;     // last: starts once the rest exists
+};
+
+// ── Internal: stream chunks through fixed windows on a worker pool ───
+// Calls fn(worker, chunk, windowBase, data, size) for every window that
+// could be read.  `worker` is in [0, threads) so callers can keep
+// per-worker output without locking.  fn may return false to stop
+// reading the rest of its chunk.  If `stopAt` is set, chunks with an
+// index >= *stopAt are skipped (or abandoned between windows).
+//
+// Each worker owns two window buffers and a WindowPrefetcher.  The next
+// window is read on the prefetcher while the current one is scanned,
+// the two buffers trading places each step, and the last `overlap`
+// bytes of each window are carried to the front of the next one so a
+// match straddling the window cut is seen exactly once.
+//
+// fn may take a sixth `bool carried` argument: true when the window's
+// last `overlap` bytes come back at the front of the next window.  Such
+// an fn is also called for a window holding only carried bytes (the
+// read after them failed), so nothing it put off is lost.
+template <typename Fn>
+static void ForEachWindowParallel(MemorySource& mem,
+                                  const std::vector<ScanChunk>& chunks,
+                                  const ScanPlan& plan, size_t overlap, Fn&& fn,
+                                  const std::atomic<size_t>* stopAt = nullptr)
+{
+    auto stopped = [stopAt](size_t idx) {
+        return stopAt && idx >= stopAt->load(std::memory_order_relaxed);
+    };
+
+    std::atomic<size_t> nextChunk{ 0 };
+
+    auto work = [&](unsigned worker) {
+        std::vector<uint8_t> cur(plan.window + overlap);
+        std::vector<uint8_t> nxt(plan.window + overlap);
+        WindowPrefetcher prefetch(mem);
+
+        for (;;) {
+            size_t idx = nextChunk.fetch_add(1);
+            if (idx >= chunks.size()) break;
+            if (stopped(idx)) continue;
+            const ScanChunk& c = chunks[idx];
+
+            size_t pos   = 0;      // chunk offset of the next unread byte
+            size_t carry = 0;      // bytes already at the front of `cur`
+            size_t want  = std::min(plan.window, c.readSize);
+            size_t got   = mem.Read(c.base, cur.data(), want);
+
+            while (pos < c.readSize) {
+                size_t dataLen   = carry + got;
+                uintptr_t winBase = c.base + pos - carry;
+                pos += want;
+
+                // Kick off the next read before scanning this window
+                bool   pending   = false;
+                size_t nextCarry = 0, nextWant = 0;
+                if (pos < c.readSize) {
+                    // Only carry across a cut when this window was read
+                    // in full; otherwise the next one isn't contiguous.
+                    nextCarry = (got == want) ? std::min(overlap, dataLen) : 0;
+                    std::memcpy(nxt.data(), cur.data() + dataLen - nextCarry, nextCarry);
+                    nextWant = std::min(plan.window, c.readSize - pos);
+                    prefetch.Post(nxt.data() + nextCarry, c.base + pos, nextWant);
+                    pending = true;
+                }
+
+                bool more = true;
+                if constexpr (std::is_invocable_v<Fn&, unsigned, const ScanChunk&, uintptr_t,
+                                                  const uint8_t*, size_t, bool>) {
+                    if (dataLen > 0)
+                        fn(worker, c, winBase, cur.data(), dataLen, nextCarry > 0);
+                } else if (got > 0) {
+                    using R = decltype(fn(worker, c, winBase, cur.data(), dataLen));
+                    if constexpr (std::is_same_v<R, bool>)
+                        more = fn(worker, c, winBase, cur.data(), dataLen);
+                    else
+                        fn(worker, c, winBase, cur.data(), dataLen);
+                }
+
+                if (!pending) break;
+                got = prefetch.Wait();
+                if (!more || stopped(idx)) break;
+                carry = nextCarry;
+                want  = nextWant;
+                std::swap(cur, nxt);
+            }
         }
+    };
+
+    if (plan.threads <= 1) {
+        work(0);
+        return;
     }
+
+    std::vector<std::thread> pool;
+    pool.reserve(plan.threads);
+    for (unsigned t = 0; t < plan.threads; ++t)
+        pool.emplace_back(work, t);
+    for (auto& th : pool)
+        th.join();
 }
 
 // ─────────────────────────────────────────────────────────────────────
-std::vector<ScanResult> PatternScan(HANDLE process, const ParsedPattern& pattern)
+std::vector<ScanResult> PatternScan(MemorySource& mem, const ParsedPattern& pattern,
+                                    const ScanOptions& opts)
 {
     std::vector<ScanResult> results;
 
     if (pattern.bytes.empty()) return results;
 
-    SYSTEM_INFO si{};
-    GetSystemInfo(&si);
+    CompiledPattern compiled = CompilePattern(pattern.View());
+
+    size_t overlap = pattern.bytes.size() - 1;
+    auto chunks = SplitIntoChunks(mem.Regions(),
+                                  opts.chunkSize, overlap);
+    ScanPlan plan = MakeScanPlan(opts, chunks.size());
+
+    std::vector<std::vector<ScanResult>> perWorker(plan.threads);
+    ForEachWindowParallel(mem, chunks, plan, overlap,
+        [&](unsigned worker, const ScanChunk&, uintptr_t winBase,
+            const uint8_t* data, size_t size) {
+            ScanBuffer(data, size, winBase, compiled, perWorker[worker]);
+        });
+
+    for (auto& w : perWorker)
+        results.insert(results.end(), w.begin(), w.end());
+
+    std::sort(results.begin(), results.end(),
+        [](const ScanResult& a, const ScanResult& b) { return a.address < b.address; });
+    results.erase(std::unique(results.begin(), results.end(),
+        [](const ScanResult& a, const ScanResult& b) { return a.address == b.address; }),
+        results.end());
+
+    return results;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+std::vector<MultiScanResult> PatternScanMulti(
+    MemorySource& mem, const std::vector<ParsedPattern>& patterns,
+    const ScanOptions& opts)
+{
+    std::vector<MultiScanResult> results;
+    if (patterns.empty()) return results;
+
+    MultiPatternMatcher matcher;
+    for (const auto& p : patterns)
+        matcher.AddPattern(p.View());
+    matcher.Build();
+    if (matcher.MaxLength() == 0) return results;
+
+    size_t overlap = matcher.MaxLength() - 1;
+    auto chunks = SplitIntoChunks(mem.Regions(),
+                                  opts.chunkSize, overlap);
+    ScanPlan plan = MakeScanPlan(opts, chunks.size());
+
+    std::vector<std::vector<MultiScanResult>> perWorker(plan.threads);
+    ForEachWindowParallel(mem, chunks, plan, overlap,
+        [&](unsigned worker, const ScanChunk& c, uintptr_t winBase,
+            const uint8_t* data, size_t size) {
+            thread_local std::vector<PatternMatch> matches;
+            thread_local MultiPatternMatcher::Scratch scratch;
+            matches.clear();
+            matcher.Find(data, size, matches, scratch);
+
+            // Shorter patterns can also match past the chunk's span
+            // (owned by the next chunk) or inside the carried overlap
+            // (a repeat, removed by the final dedup).
+            for (const auto& m : matches) {
+                uintptr_t addr = winBase + m.offset;
+                if (addr >= c.base + c.span) break;
+                perWorker[worker].push_back({ addr, m.patternId });
+            }
+        });
+
+    for (auto& w : perWorker)
+        results.insert(results.end(), w.begin(), w.end());
+
+    std::sort(results.begin(), results.end(),
+        [](const MultiScanResult& a, const MultiScanResult& b) {
+            if (a.address != b.address) return a.address < b.address;
+            return a.patternId < b.patternId;
+        });
+    results.erase(std::unique(results.begin(), results.end(),
+        [](const MultiScanResult& a, const MultiScanResult& b) {
+            return a.address == b.address && a.patternId == b.patternId;
+        }),
+        results.end());
+
+    return results;
+}
+
+// =====================================================================
+//  Early-exit scans
+// =====================================================================
+
+// ── Internal: lowest `maxHits` matches over a chunk list ─────────────
+// Chunks are in address order, so once the hits found in chunks
+// [0, c] reach maxHits, nothing in a chunk above c can be among the
+// lowest ones: every chunk > c is skipped and chunk c itself stops.
+// Hits are only counted inside a chunk's own span, so a match in the
+// overlap is counted once, by the chunk it starts in.
+static std::vector<ScanResult> ScanChunksFirst(MemorySource& mem,
+                                               const std::vector<ScanChunk>& chunks,
+                                               const CompiledPattern& compiled,
+                                               size_t maxHits, const ScanOptions& opts)
+{
+    std::vector<ScanResult> results;
+    if (chunks.empty() || maxHits == 0) return results;
+
+    size_t overlap = compiled.length - 1;
+    ScanPlan plan = MakeScanPlan(opts, chunks.size());
+
+    std::vector<std::vector<ScanResult>> perChunk(chunks.size());
+    std::vector<size_t> counts(chunks.size(), 0);   // guarded by mtx
+    std::atomic<size_t> stopAt{ SIZE_MAX };         // no cut yet
+    std::mutex mtx;
+
+    ForEachWindowParallel(mem, chunks, plan, overlap,
+        [&](unsigned, const ScanChunk& c, uintptr_t winBase,
+            const uint8_t* data, size_t size) -> bool {
+            size_t idx = static_cast<size_t>(&c - chunks.data());
+            auto& hits = perChunk[idx];
+            size_t want = maxHits - std::min(maxHits, hits.size());
+            if (want == 0) return false;
+
+            // Hits already taken from the carried overlap come back
+            // again; let the kernel find that many more
+            for (auto it = hits.rbegin(); it != hits.rend() && it->address >= winBase; ++it)
+                ++want;
+
+            thread_local std::vector<size_t> offsets;
+            offsets.clear();
+            FindMatches(data, size, compiled, offsets, want);
+
+            size_t before = hits.size();
+            for (size_t off : offsets) {
+                uintptr_t addr = winBase + off;
+                if (addr >= c.base + c.span) break;
+                if (!hits.empty() && addr <= hits.back().address) continue;  // carried overlap
+                hits.push_back({ addr });
+            }
+            if (hits.size() == before) return true;
+
+            // Lower the cut to the first chunk whose prefix has enough hits
+            std::lock_guard<std::mutex> lk(mtx);
+            counts[idx] = hits.size();
+            size_t sum = 0;
+            for (size_t i = 0; i < std::min(stopAt.load(), chunks.size()); ++i) {
+                sum += counts[i];
+                if (sum >= maxHits) {
+                    stopAt.store(i + 1);
+                    break;
+                }
+            }
+            return idx + 1 < stopAt.load();
+        },
+        &stopAt);
+
+    for (size_t i = 0; i < std::min(stopAt.load(), chunks.size()); ++i)
+        results.insert(results.end(), perChunk[i].begin(), perChunk[i].end());
+
+    std::sort(results.begin(), results.end(),
+        [](const ScanResult& a, const ScanResult& b) { return a.address < b.address; });
+    if (results.size() > maxHits) results.resize(maxHits);
+    return results;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+void PatternScanEach(MemorySource& mem, const ParsedPattern& pattern,
+                     const ScanCallback& onHit, const ScanOptions& opts)
+{
+    if (pattern.bytes.empty() || !onHit) return;
+
+    CompiledPattern compiled = CompilePattern(pattern.View());
+    size_t overlap = pattern.bytes.size() - 1;
+    auto chunks = SplitIntoChunks(mem.Regions(),
+                                  opts.chunkSize, overlap);
+    ScanPlan plan = MakeScanPlan(opts, chunks.size());
+
+    // stopAt = 0 skips every remaining chunk
+    std::atomic<size_t> stopAt{ chunks.size() };
+    std::vector<uintptr_t> lastHit(chunks.size(), 0);   // per chunk
+    std::mutex mtx;
 
-    uintptr_t addr = reinterpret_cast<uintptr_t>(si.lpMinimumApplicationAddress);
-    uintptr_t end  = reinterpret_cast<uintptr_t>(si.lpMaximumApplicationAddress);
+    ForEachWindowParallel(mem, chunks, plan, overlap,
+        [&](unsigned, const ScanChunk& c, uintptr_t winBase,
+            const uint8_t* data, size_t size) -> bool {
+            size_t idx = static_cast<size_t>(&c - chunks.data());
+
+            thread_local std::vector<size_t> offsets;
+            offsets.clear();
+            FindMatches(data, size, compiled, offsets);
+
+            std::lock_guard<std::mutex> lk(mtx);
+            for (size_t off : offsets) {
+                uintptr_t addr = winBase + off;
+                if (lastHit[idx] && addr <= lastHit[idx]) continue;   // carried overlap
+                if (addr >= c.base + c.span) break;
+                lastHit[idx] = addr;
+                if (stopAt.load() == 0) return false;
+                if (!onHit(addr)) {
+                    stopAt.store(0);
+                    return false;
+                }
+            }
+            return stopAt.load() != 0;
+        },
+        &stopAt);
+}
+
+// ─────────────────────────────────────────────────────────────────────
+std::vector<ScanResult> PatternScanFirst(MemorySource& mem, const ParsedPattern& pattern,
+                                         size_t maxHits, const ScanOptions& opts)
+{
+    if (pattern.bytes.empty()) return {};
+
+    CompiledPattern compiled = CompilePattern(pattern.View());
+    auto chunks = SplitIntoChunks(mem.Regions(),
+                                  opts.chunkSize, pattern.bytes.size() - 1);
+    return ScanChunksFirst(mem, chunks, compiled, maxHits, opts);
+}
+
+// ─────────────────────────────────────────────────────────────────────
+uintptr_t PatternScanModule(MemorySource& mem, const char* moduleName,
+                            const ParsedPattern& pattern, const ScanOptions& opts)
+{
+    if (pattern.bytes.empty() || !moduleName) return 0;
 
-    MEMORY_BASIC_INFORMATION mbi{};
-    std::vector<uint8_t> buf;
+    // Module names compare case-insensitively (Windows file names)
+    auto sameName = [](const std::string& a, const char* b) {
+        size_t n = std::strlen(b);
+        if (a.size() != n) return false;
+        for (size_t i = 0; i < n; ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) !=
+                std::tolower(static_cast<unsigned char>(b[i])))
+                return false;
+        }
+        return true;
+    };
 
-    while (addr < end) {
-        if (VirtualQueryEx(process, reinterpret_cast<LPCVOID>(addr),
-                           &mbi, sizeof(mbi)) == 0)
+    const ModuleInfo* mod = nullptr;
+    auto modules = mem.Modules();
+    for (const auto& m : modules) {
+        if (sameName(m.name, moduleName)) {
+            mod = &m;
             break;
+        }
+    }
+    if (!mod) {
+        std::cout << "[scanner] Module not found: " << moduleName << "\n";
+        return 0;
+    }
 
-        // Only scan committed, readable regions
-        if (mbi.State == MEM_COMMIT &&
-            (mbi.Protect == PAGE_READWRITE      ||
-             mbi.Protect == PAGE_READONLY        ||
-             mbi.Protect == PAGE_EXECUTE_READ    ||
-             mbi.Protect == PAGE_EXECUTE_READWRITE ||
-             mbi.Protect == PAGE_WRITECOPY       ||
-             mbi.Protect == PAGE_EXECUTE_WRITECOPY))
-        {
-            size_t regionSize = mbi.RegionSize;
-            buf.resize(regionSize);
-
-            SIZE_T bytesRead = 0;
-            if (ReadProcessMemory(process,
-                                  reinterpret_cast<LPCVOID>(addr),
-                                  buf.data(), regionSize, &bytesRead)
-                && bytesRead > 0)
+    // Readable regions clipped to the module image
+    std::vector<ScanRegion> regions;
+    uintptr_t modEnd = mod->base + mod->size;
+    for (const auto& r : mem.Regions()) {
+        uintptr_t lo = std::max(r.base, mod->base);
+        uintptr_t hi = std::min(r.base + r.size, modEnd);
+        if (lo >= hi) continue;
+        ScanRegion clipped = r;
+        clipped.base = lo;
+        clipped.size = static_cast<size_t>(hi - lo);
+        regions.push_back(clipped);
+    }
+
+    CompiledPattern compiled = CompilePattern(pattern.View());
+    auto chunks = SplitIntoChunks(regions, opts.chunkSize, pattern.bytes.size() - 1);
+    auto hits = ScanChunksFirst(mem, chunks, compiled, 1, opts);
+    return hits.empty() ? 0 : hits.front().address;
+}
+
+// =====================================================================
+//  Incremental rescan
+// =====================================================================
+
+// ── Internal: 64-bit fingerprint of one 4 KB page ────────────────────
+// Four independent multiply/rotate lanes so the loop isn't latency
+// bound; only used to detect change, not for security.
+static uint64_t HashPage(const uint8_t* p)
+{
+    constexpr uint64_t k0 = 0x9E3779B97F4A7C15ull;
+    constexpr uint64_t k1 = 0xC2B2AE3D27D4EB4Full;
+    uint64_t h[4] = { k0, k1, k0 ^ k1, k0 + k1 };
+
+    for (size_t i = 0; i < kPageSize; i += 32) {
+        for (int l = 0; l < 4; ++l) {
+            uint64_t v;
+            std::memcpy(&v, p + i + l * 8, sizeof(v));
+            h[l] ^= v * k1;
+            h[l]  = ((h[l] << 31) | (h[l] >> 33)) * k0;
+        }
+    }
+
+    uint64_t r = h[0] ^ (h[1] * k1) ^ (h[2] * k0) ^ h[3];
+    r ^= r >> 29;
+    r *= k1;
+    r ^= r >> 32;
+    return r;
+}
+
+using PageHashes = std::vector<std::pair<uintptr_t, uint64_t>>;
+
+static const uint64_t* FindPage(const PageHashes& pages, uintptr_t page)
+{
+    auto it = std::lower_bound(pages.begin(), pages.end(), page,
+        [](const std::pair<uintptr_t, uint64_t>& e, uintptr_t v) { return e.first < v; });
+    return (it != pages.end() && it->first == page) ? &it->second : nullptr;
+}
+
+void IncrementalScanner::Reset()
+{
+    patBytes.clear();
+    patMask.clear();
+    pageHashes.clear();
+    hits.clear();
+}
+
+// ─────────────────────────────────────────────────────────────────────
+std::vector<ScanResult> IncrementalScanner::Scan(MemorySource& mem,
+                                                 const ParsedPattern& pattern,
+                                                 const ScanOptions& opts)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    stats = {};
+
+    if (pattern.bytes.empty()) {
+        Reset();
+        return {};
+    }
+
+    bool full = pageHashes.empty() ||
+                pattern.bytes != patBytes || pattern.mask != patMask;
+
+    CompiledPattern compiled = CompilePattern(pattern.View());
+    size_t overlap = pattern.bytes.size() - 1;
+
+    // ── One pass: fingerprint every page, scan the dirty ones ────────
+    // A hit depends on the page it starts in and the `overlap` bytes
+    // after it, so a page is dirty when it or one of its next `spill`
+    // pages in the same region changed (or stopped being readable).
+    // Windows carry their last `spill` pages to the front of the next
+    // one; a page whose successors run past a carried window is decided
+    // in the next window instead.  Either way a dirty page is scanned
+    // straight from the buffer that fingerprinted it.
+    size_t spill = (overlap + kPageSize - 1) / kPageSize;
+    size_t tail  = spill * kPageSize;
+
+    auto regions = mem.Regions();
+    auto chunks  = SplitIntoChunks(regions, opts.chunkSize, tail);
+    ScanPlan plan = MakeScanPlan(opts, chunks.size());
+
+    std::vector<PageHashes>              hashPerWorker(plan.threads);
+    std::vector<std::vector<uintptr_t>>  dirtyPerWorker(plan.threads);
+    std::vector<std::vector<ScanResult>> hitsPerWorker(plan.threads);
+
+    ForEachWindowParallel(mem, chunks, plan, tail,
+        [&](unsigned worker, const ScanChunk& c, uintptr_t winBase,
+            const uint8_t* data, size_t size, bool carried) {
+            if (full)
+                ScanBuffer(data, size, winBase, compiled, hitsPerWorker[worker]);
+
+            uintptr_t dataEnd = winBase + size;
+            uintptr_t spanEnd = c.base + c.span;
+            uintptr_t readEnd = c.base + c.readSize;    // < base + span + tail only at a region end
+            uintptr_t first   = (winBase + kPageSize - 1) & ~(kPageSize - 1);
+
+            thread_local std::vector<uint64_t> winHashes;
+            winHashes.clear();
+            for (uintptr_t page = first; page + kPageSize <= dataEnd; page += kPageSize)
+                winHashes.push_back(HashPage(data + (page - winBase)));
+            auto hashOf = [&](uintptr_t page) { return winHashes[(page - first) / kPageSize]; };
+
+            // Consecutive dirty pages are scanned as one run, with the
+            // bytes after it that a hit on its last page may cover
+            uintptr_t runStart = 0, runEnd = 0;
+            auto flush = [&] {
+                if (runEnd == runStart) return;
+                size_t len = static_cast<size_t>(std::min(runEnd + overlap, dataEnd) - runStart);
+                ScanBuffer(data + (runStart - winBase), len, runStart, compiled,
+                           hitsPerWorker[worker]);
+                runStart = runEnd = 0;
+            };
+
+            for (uintptr_t page = first; page + kPageSize <= dataEnd && page < spanEnd;
+                 page += kPageSize)
             {
-                ScanBuffer(buf.data(), bytesRead,
-                           addr, pattern, results);
+                if (carried && page + (spill + 1) * kPageSize > dataEnd) break;
+
+                uint64_t h = hashOf(page);
+                hashPerWorker[worker].push_back({ page, h });
+                if (full) continue;
+
+                const uint64_t* was = FindPage(pageHashes, page);
+                bool dirty = !was || *was != h;
+                for (size_t j = 1; j <= spill && !dirty; ++j) {
+                    uintptr_t next = page + j * kPageSize;
+                    if (next >= readEnd) break;                 // past the region end
+                    was = FindPage(pageHashes, next);
+                    if (next + kPageSize <= dataEnd)
+                        dirty = !was || *was != hashOf(next);
+                    else
+                        dirty = was != nullptr;                 // no longer readable
+                }
+                if (!dirty) continue;
+
+                dirtyPerWorker[worker].push_back(page);
+                if (page != runEnd) {
+                    flush();
+                    runStart = page;
+                }
+                runEnd = page + kPageSize;
             }
-        }
+            flush();
+        });
 
-        addr += mbi.RegionSize;
+    PageHashes fresh;
+    for (auto& w : hashPerWorker)
+        fresh.insert(fresh.end(), w.begin(), w.end());
+    std::sort(fresh.begin(), fresh.end());
+    fresh.erase(std::unique(fresh.begin(), fresh.end()), fresh.end());
+
+    std::vector<ScanResult> found;
+    for (auto& w : hitsPerWorker)
+        found.insert(found.end(), w.begin(), w.end());
+
+    stats.pagesTotal = fresh.size();
+
+    if (full) {
+        stats.pagesScanned = fresh.size();
+    } else {
+        std::vector<uintptr_t> dirty;
+        for (auto& w : dirtyPerWorker)
+            dirty.insert(dirty.end(), w.begin(), w.end());
+        std::sort(dirty.begin(), dirty.end());
+        stats.pagesScanned = dirty.size();
+
+        // Carry forward old hits on pages that are still clean
+        for (const auto& h : hits) {
+            uintptr_t page = h.address & ~(kPageSize - 1);
+            if (FindPage(fresh, page) &&
+                !std::binary_search(dirty.begin(), dirty.end(), page))
+            {
+                found.push_back(h);
+            }
+        }
     }
 
-    return results;
+    std::sort(found.begin(), found.end(),
+        [](const ScanResult& a, const ScanResult& b) { return a.address < b.address; });
+    found.erase(std::unique(found.begin(), found.end(),
+        [](const ScanResult& a, const ScanResult& b) { return a.address == b.address; }),
+        found.end());
+
+    patBytes   = pattern.bytes;
+    patMask    = pattern.mask;
+    pageHashes = std::move(fresh);
+    hits       = found;
+
+    stats.fullScan = full;
+    stats.ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    return found;
 }
 
 // ─────────────────────────────────────────────────────────────────────
-std::vector<ScanResult> PatternScanRange(HANDLE process,
-                                          const ParsedPattern& pattern,
-                                          uintptr_t start, size_t size)
+void PatternScanRange(MemorySource& mem, const ParsedPattern& pattern,
+                      uintptr_t start, size_t size, std::vector<ScanResult>& out)
 {
-    std::vector<ScanResult> results;
-    if (pattern.bytes.empty() || size == 0) return results;
+    if (pattern.bytes.empty() || size == 0) return;
 
-    std::vector<uint8_t> buf(size);
-    SIZE_T bytesRead = 0;
+    // Stream the range through one reused window instead of reading it
+    // whole; windows overlap by pattern length - 1 and each owns the
+    // matches starting in its first `window` bytes.  Like a single read,
+    // the scan stops at the first unreadable byte.
+    const size_t overlap = pattern.bytes.size() - 1;
+    const size_t window  = std::min(size, kMinWindow);
+    auto buf = ScratchBuffer(window + overlap);
 
-    if (ReadProcessMemory(process, reinterpret_cast<LPCVOID>(start),
-                          buf.data(), size, &bytesRead)
-        && bytesRead > 0)
-    {
-        ScanBuffer(buf.data(), bytesRead, start, pattern, results);
+    CompiledPattern compiled = CompilePattern(pattern.View());
+    thread_local std::vector<ScanResult> hits;
+
+    for (size_t done = 0; done < size; done += window) {
+        size_t want = std::min(window + overlap, size - done);
+        size_t got  = mem.Read(start + done, buf.data(), want);
+        bool   last = got < want || done + want == size;
+
+        hits.clear();
+        ScanBuffer(buf.data(), got, start + done, compiled, hits);
+        for (const auto& h : hits)
+            if (last || h.address - (start + done) < window)
+                out.push_back(h);
+
+        if (last) break;
     }
+}
 
+std::vector<ScanResult> PatternScanRange(MemorySource& mem,
+                                         const ParsedPattern& pattern,
+                                         uintptr_t start, size_t size)
+{
+    std::vector<ScanResult> results;
+    PatternScanRange(mem, pattern, start, size, results);
     return results;
 }
 
 // ─────────────────────────────────────────────────────────────────────
-uintptr_t ResolveRIP(HANDLE process, uintptr_t instrAddr,
+uintptr_t ResolveRIP(MemorySource& mem, uintptr_t instrAddr,
                      int dispOffset, int instrLen)
 {
-    int32_t disp = 0;
-    SIZE_T bytesRead = 0;
-
-    if (!ReadProcessMemory(process,
-                           reinterpret_cast<LPCVOID>(instrAddr + dispOffset),
-                           &disp, sizeof(disp), &bytesRead)
-        || bytesRead != sizeof(disp))
-    {
-        return 0;
-    }
+    auto disp = ReadValue<int32_t>(mem, instrAddr + dispOffset);
+    if (!disp) return 0;
 
-    return instrAddr + instrLen + disp;
+    return instrAddr + instrLen + *disp;
 }
@@ -1,44 +1,149 @@
 #pragma once
 
-#include <Windows.h>
+#include "pattern.h"
+#include "memory_source.h"
+
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
 // ── AOB Pattern Scanner ──────────────────────────────────────────────
-// Scans committed memory regions of an external process for byte
-// patterns with wildcard support.
-//
-// Pattern format: "48 8B 05 ?? ?? ?? ?? 48 85 C0"
-//   - Two hex chars = exact byte match
-//   - "??" or "?"   = wildcard (matches any byte)
+// Scans the readable regions of a MemorySource for byte patterns with
+// wildcard support.  Pattern syntax and the runtime /
+// compile-time pattern types live in pattern.h.
 
 struct ScanResult {
     uintptr_t address = 0;
 };
 
-// Parse a pattern string into byte array + mask.
-// mask[i] == true means bytes[i] must match exactly.
-struct ParsedPattern {
-    std::vector<uint8_t> bytes;
-    std::vector<bool>    mask;    // true = must match, false = wildcard
+struct MultiScanResult {
+    uintptr_t address   = 0;
+    size_t    patternId = 0;    // index into the pattern list
 };
 
-ParsedPattern ParsePattern(const std::string& pattern);
+// Regions come from MemorySource::Regions().
+using ScanRegion = MemoryRegion;
+
+// Whole-process scan tuning.
+// The region map is enumerated once, regions are cut into chunks of
+// `chunkSize` bytes (overlapping by pattern length - 1 so no match is
+// lost at a cut) and the chunks are scanned on a worker pool.
+// Each worker streams its chunk through two reusable windows of
+// 64 KB..4 MB, sized so all read buffers together stay within
+// `memoryBudget`; the worker count is lowered if the budget is tight.
+struct ScanOptions {
+    unsigned threads      = 0;            // 0 = one per hardware thread
+    size_t   chunkSize    = 16u << 20;    // bytes of match starts per chunk
+    size_t   memoryBudget = 32u << 20;    // cap on all read buffers
+};
+
+// Scan all readable regions of `mem` for `pattern`.
+// Returns addresses of all matches, sorted and deduplicated.
+std::vector<ScanResult> PatternScan(MemorySource& mem, const ParsedPattern& pattern,
+                                    const ScanOptions& opts = {});
+
+// Same, for a compile-time pattern (no runtime parsing; the same
+// runtime-dispatched kernels).
+template <FixedString S>
+std::vector<ScanResult> PatternScan(MemorySource& mem, Pattern<S>,
+                                    const ScanOptions& opts = {})
+{
+    static const ParsedPattern parsed = Pattern<S>::ToParsed();
+    return PatternScan(mem, parsed, opts);
+}
+
+// Scan for several patterns at once.  Every region is read and walked
+// a single time; hits are tagged with the index of the pattern that
+// matched and come back in address order.
+std::vector<MultiScanResult> PatternScanMulti(
+    MemorySource& mem, const std::vector<ParsedPattern>& patterns,
+    const ScanOptions& opts = {});
+
+// ── Early-exit scans ─────────────────────────────────────────────────
+// For signature resolution, where only the first or the unique match
+// matters.  Both stop reading memory as soon as the answer is known.
+
+// Called for each hit; return false to stop the scan.  Calls are
+// serialized.  Hits within a chunk arrive in address order, but chunks
+// are scanned in parallel, so use threads = 1 for a strict address-order
+// stream.  No call is made after the callback returns false.
+using ScanCallback = std::function<bool(uintptr_t address)>;
+
+void PatternScanEach(MemorySource& mem, const ParsedPattern& pattern,
+                     const ScanCallback& onHit, const ScanOptions& opts = {});
 
-// Scan all committed, readable regions of `process` for `pattern`.
-// Returns addresses of all matches.
-std::vector<ScanResult> PatternScan(HANDLE process, const ParsedPattern& pattern);
+// The `maxHits` lowest matching addresses, sorted.  Once enough hits
+// are known below some point, chunks above it are skipped, so the scan
+// ends as soon as the answer is fixed.  maxHits = 2 is enough to check
+// that a signature is unique.
+std::vector<ScanResult> PatternScanFirst(MemorySource& mem, const ParsedPattern& pattern,
+                                         size_t maxHits = 1,
+                                         const ScanOptions& opts = {});
+
+// First match inside one loaded module (e.g. "jvm.dll"), or 0.
+// Only the module's readable pages are read.
+uintptr_t PatternScanModule(MemorySource& mem, const char* moduleName,
+                            const ParsedPattern& pattern,
+                            const ScanOptions& opts = {});
+
+template <FixedString S>
+std::vector<ScanResult> PatternScanFirst(MemorySource& mem, Pattern<S>,
+                                         size_t maxHits = 1,
+                                         const ScanOptions& opts = {})
+{
+    static const ParsedPattern parsed = Pattern<S>::ToParsed();
+    return PatternScanFirst(mem, parsed, maxHits, opts);
+}
+
+// ── Incremental rescan ───────────────────────────────────────────────
+// Remembers a 64-bit fingerprint of every scanned 4 KB page and the hits
+// of the last scan.  Scanning again with the same pattern only rescans
+// pages whose fingerprint changed (or whose successor changed, for hits
+// running over the page end) and carries the other hits forward.
+// Every page is still read once to fingerprint it; dirty pages are
+// scanned from that same read, clean ones not at all.
+// A different pattern, or the first call, does a full scan.
+class IncrementalScanner {
+public:
+    struct Stats {
+        bool   fullScan     = false;
+        size_t pagesTotal   = 0;
+        size_t pagesScanned = 0;
+        double ms           = 0;
+    };
+
+    std::vector<ScanResult> Scan(MemorySource& mem, const ParsedPattern& pattern,
+                                 const ScanOptions& opts = {});
+
+    // Forget all state; the next Scan() is a full scan.
+    void Reset();
+
+    const Stats& LastStats() const { return stats; }
+
+private:
+    std::vector<uint8_t> patBytes;
+    std::vector<uint8_t> patMask;
+    std::vector<std::pair<uintptr_t, uint64_t>> pageHashes;   // sorted by page
+    std::vector<ScanResult> hits;
+    Stats stats;
+};
 
 // Scan only within a specific address range.
-std::vector<ScanResult> PatternScanRange(HANDLE process, const ParsedPattern& pattern,
+std::vector<ScanResult> PatternScanRange(MemorySource& mem, const ParsedPattern& pattern,
                                          uintptr_t start, size_t size);
 
+// Same, appending to `out`.  The range is streamed through a reused
+// per-thread window, so with a warmed-up `out` nothing is allocated
+// beyond compiling the pattern.
+void PatternScanRange(MemorySource& mem, const ParsedPattern& pattern,
+                      uintptr_t start, size_t size, std::vector<ScanResult>& out);
+
 // Resolve a RIP-relative address.
 // Given a match at `instrAddr` where the 32-bit displacement is at
 // offset `dispOffset` within the pattern, and the instruction is
 // `instrLen` bytes total, compute the absolute target:
 //   target = instrAddr + instrLen + *(int32_t*)(instrAddr + dispOffset)
-// Reads the displacement from the remote process.
-uintptr_t ResolveRIP(HANDLE process, uintptr_t instrAddr,
+// Reads the displacement from the target.
+uintptr_t ResolveRIP(MemorySource& mem, uintptr_t instrAddr,
                      int dispOffset, int instrLen);
@@ -0,0 +1,283 @@
+#include "snapshot_file.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr size_t kCaptureChunk = 1u << 20;
+
+// =====================================================================
+//  Capture
+// =====================================================================
+
+uint64_t SaveSnapshotFile(MemorySource& src, const std::string& file)
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out) return 0;
+
+    auto regions = src.Regions();
+    auto mods    = src.Modules();
+
+    SnapshotHeader header;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<SnapshotRegionEntry> table;
+    std::vector<uint8_t> buf(kCaptureChunk);
+    uint64_t pos = sizeof(header);
+    const char zeros[kSnapshotAlign] = {};
+
+    for (const auto& r : regions) {
+        uint64_t start = (pos + kSnapshotAlign - 1) & ~(kSnapshotAlign - 1);
+        out.write(zeros, static_cast<std::streamsize>(start - pos));
+
+        // Stream the region; stop at the first chunk that reads short
+        uint64_t got = 0;
+        while (got < r.size) {
+            size_t want = static_cast<size_t>(std::min<uint64_t>(buf.size(), r.size - got));
+            size_t n = src.Read(r.base + static_cast<uintptr_t>(got), buf.data(), want);
+            out.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(n));
+            got += n;
+            if (n < want) break;
+        }
+
+        if (got == 0) {
+            out.seekp(static_cast<std::streamoff>(pos));   // drop the padding
+            continue;
+        }
+
+        SnapshotRegionEntry e;
+        e.base       = r.base;
+        e.size       = got;
+        e.dataOffset = start;
+        e.protect    = r.protect;
+        e.type       = r.type;
+
+        auto it = std::upper_bound(mods.begin(), mods.end(), r.base,
+            [](uintptr_t a, const ModuleInfo& m) { return a < m.base; });
+        if (it != mods.begin() && r.base - (it - 1)->base < (it - 1)->size)
+            e.module = static_cast<uint32_t>(it - 1 - mods.begin());
+
+        table.push_back(e);
+        header.dataBytes += got;
+        pos = start + got;
+    }
+
+    // Tables
+    std::string strings;
+    std::vector<SnapshotModuleEntry> modTable;
+    for (const auto& m : mods) {
+        SnapshotModuleEntry e;
+        e.base       = m.base;
+        e.size       = m.size;
+        e.nameOffset = static_cast<uint32_t>(strings.size());
+        e.nameLength = static_cast<uint32_t>(m.name.size());
+        strings += m.name;
+        modTable.push_back(e);
+    }
+
+    // Tables are read in place, so keep them 8-byte aligned
+    uint64_t tablePos = (pos + 7) & ~uint64_t(7);
+    out.write(zeros, static_cast<std::streamsize>(tablePos - pos));
+    pos = tablePos;
+
+    header.regionCount = static_cast<uint32_t>(table.size());
+    header.moduleCount = static_cast<uint32_t>(modTable.size());
+    header.regionTable = pos;
+    header.moduleTable = header.regionTable + table.size() * sizeof(SnapshotRegionEntry);
+    header.stringTable = header.moduleTable + modTable.size() * sizeof(SnapshotModuleEntry);
+    header.stringSize  = strings.size();
+    header.fileSize    = header.stringTable + strings.size();
+
+    out.write(reinterpret_cast<const char*>(table.data()),
+              static_cast<std::streamsize>(table.size() * sizeof(SnapshotRegionEntry)));
+    out.write(reinterpret_cast<const char*>(modTable.data()),
+              static_cast<std::streamsize>(modTable.size() * sizeof(SnapshotModuleEntry)));
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out) return 0;
+
+    std::cout << "[snapshot] Wrote " << file << ": " << table.size()
+              << " regions, " << (header.dataBytes >> 20) << " MB\n";
+    return header.dataBytes;
+}
+
+// =====================================================================
+//  Replay
+// =====================================================================
+
+MappedSnapshotSource::~MappedSnapshotSource()
+{
+    Close();
+}
+
+bool MappedSnapshotSource::Open(const std::string& file)
+{
+    Close();
+
+#if defined(_WIN32)
+    fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(SnapshotHeader))) {
+        Close();
+        return false;
+    }
+    mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { Close(); return false; }
+
+    base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!base) { Close(); return false; }
+    mapSize = static_cast<uint64_t>(size.QuadPart);
+#else
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);                         // the mapping keeps the file alive
+    if (p == MAP_FAILED) return false;
+
+    base    = static_cast<const uint8_t*>(p);
+    mapSize = static_cast<uint64_t>(st.st_size);
+#endif
+
+    // ── Validate ─────────────────────────────────────────────────────
+    std::memcpy(&header, base, sizeof(header));
+    auto fits = [&](uint64_t off, uint64_t len) {
+        return off <= mapSize && len <= mapSize - off;
+    };
+
+    bool ok = header.magic == kSnapshotMagic &&
+              header.version == kSnapshotVersion &&
+              header.fileSize <= mapSize &&
+              fits(header.regionTable, uint64_t(header.regionCount) * sizeof(SnapshotRegionEntry)) &&
+              fits(header.moduleTable, uint64_t(header.moduleCount) * sizeof(SnapshotModuleEntry)) &&
+              fits(header.stringTable, header.stringSize) &&
+              header.regionTable % alignof(SnapshotRegionEntry) == 0;
+
+    if (ok) {
+        regions = reinterpret_cast<const SnapshotRegionEntry*>(base + header.regionTable);
+        for (uint32_t i = 0; i < header.regionCount && ok; ++i) {
+            const auto& r = regions[i];
+            ok = fits(r.dataOffset, r.size) &&
+                 (i == 0 || regions[i - 1].base + regions[i - 1].size <= r.base);
+        }
+    }
+
+    if (ok) {
+        const auto* mt = reinterpret_cast<const SnapshotModuleEntry*>(base + header.moduleTable);
+        const char* strings = reinterpret_cast<const char*>(base + header.stringTable);
+        for (uint32_t i = 0; i < header.moduleCount && ok; ++i) {
+            ok = uint64_t(mt[i].nameOffset) + mt[i].nameLength <= header.stringSize;
+            if (!ok) break;
+            ModuleInfo m;
+            m.name = std::string(strings + mt[i].nameOffset, mt[i].nameLength);
+            m.base = static_cast<uintptr_t>(mt[i].base);
+            m.size = static_cast<size_t>(mt[i].size);
+            modules.push_back(std::move(m));
+        }
+    }
+
+    if (!ok) {
+        std::cout << "[snapshot] " << file << " is not a valid snapshot\n";
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedSnapshotSource::Close()
+{
+#if defined(_WIN32)
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle(mapping);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    mapping    = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (base) munmap(const_cast<uint8_t*>(base), static_cast<size_t>(mapSize));
+#endif
+    base    = nullptr;
+    mapSize = 0;
+    regions = nullptr;
+    header  = {};
+    modules.clear();
+}
+
+ptrdiff_t MappedSnapshotSource::Find(uintptr_t addr) const
+{
+    const auto* end = regions + header.regionCount;
+    const auto* it = std::upper_bound(regions, end, addr,
+        [](uintptr_t a, const SnapshotRegionEntry& r) { return a < r.base; });
+    if (it == regions) return -1;
+    --it;
+    if (addr - it->base >= it->size) return -1;
+    return it - regions;
+}
+
+const uint8_t* MappedSnapshotSource::Data(uintptr_t addr, size_t size) const
+{
+    ptrdiff_t i = Find(addr);
+    if (i < 0) return nullptr;
+    const auto& r = regions[i];
+    if (size > r.size - (addr - r.base)) return nullptr;
+    return base + r.dataOffset + (addr - r.base);
+}
+
+size_t MappedSnapshotSource::Read(uintptr_t addr, void* dst, size_t size)
+{
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t done = 0;
+
+    // Walk adjacent regions; stop at the first gap
+    ptrdiff_t i = Find(addr);
+    if (i < 0) return 0;
+
+    for (; done < size && i < static_cast<ptrdiff_t>(header.regionCount); ++i) {
+        const auto& r = regions[i];
+        uintptr_t cur = addr + done;
+        if (cur < r.base || cur - r.base >= r.size) break;
+
+        size_t n = static_cast<size_t>(std::min<uint64_t>(size - done, r.size - (cur - r.base)));
+        std::memcpy(out + done, base + r.dataOffset + (cur - r.base), n);
+        done += n;
+    }
+    return done;
+}
+
+std::vector<MemoryRegion> MappedSnapshotSource::Regions()
+{
+    std::vector<MemoryRegion> out;
+    out.reserve(header.regionCount);
+    for (uint32_t i = 0; i < header.regionCount; ++i) {
+        MemoryRegion r;
+        r.base    = static_cast<uintptr_t>(regions[i].base);
+        r.size    = static_cast<size_t>(regions[i].size);
+        r.protect = regions[i].protect;
+        r.type    = regions[i].type;
+        out.push_back(r);
+    }
+    return out;
+}
+
+std::string MappedSnapshotSource::RegionModule(size_t i) const
+{
+    if (i >= header.regionCount) return {};
+    uint32_t m = regions[i].module;
+    return m < modules.size() ? modules[m].name : std::string();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "memory_source.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ── Snapshot files (.wsnap) ──────────────────────────────────────────
+// A frozen copy of a target's readable memory, laid out so it can be
+// memory-mapped and served in place: opening a multi-GB snapshot costs
+// one mmap, and reads are copies straight out of the page cache.
+//
+// Layout (little-endian, all offsets absolute):
+//
+//   SnapshotHeader                       at 0
+//   region data                          each region at a 4 KB-aligned offset
+//   SnapshotRegionEntry[regionCount]     region table, sorted by base
+//   SnapshotModuleEntry[moduleCount]     module table, sorted by base
+//   string table                         module names, not terminated
+//
+// The tables go at the end so capture can stream region data without
+// knowing in advance how much of each region will read back.
+
+constexpr uint32_t kSnapshotMagic   = 0x50414E53;   // "SNAP"
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr uint64_t kSnapshotAlign   = 4096;
+constexpr uint32_t kSnapshotNoModule = 0xFFFFFFFF;
+
+struct SnapshotHeader {
+    uint32_t magic       = kSnapshotMagic;
+    uint32_t version     = kSnapshotVersion;
+    uint32_t regionCount = 0;
+    uint32_t moduleCount = 0;
+    uint64_t regionTable = 0;       // file offset
+    uint64_t moduleTable = 0;
+    uint64_t stringTable = 0;
+    uint64_t stringSize  = 0;
+    uint64_t dataBytes   = 0;       // sum of region sizes
+    uint64_t fileSize    = 0;
+};
+
+struct SnapshotRegionEntry {
+    uint64_t base       = 0;
+    uint64_t size       = 0;
+    uint64_t dataOffset = 0;        // 4 KB aligned
+    uint32_t protect    = 0;        // mem_prot::*
+    uint32_t type       = 0;        // mem_type::*
+    uint32_t module     = kSnapshotNoModule;   // index into the module table
+    uint32_t reserved   = 0;
+};
+
+struct SnapshotModuleEntry {
+    uint64_t base       = 0;
+    uint64_t size       = 0;
+    uint32_t nameOffset = 0;        // into the string table
+    uint32_t nameLength = 0;
+};
+
+static_assert(sizeof(SnapshotHeader)      == 64);
+static_assert(sizeof(SnapshotRegionEntry) == 40);
+static_assert(sizeof(SnapshotModuleEntry) == 24);
+
+// Capture every readable region and the module list of `src` into
+// `file`.  Regions are streamed through a small buffer, never held in
+// memory whole; a region that stops reading part-way is kept up to that
+// point.  Returns the number of data bytes written, or 0 on failure.
+uint64_t SaveSnapshotFile(MemorySource& src, const std::string& file);
+
+// =====================================================================
+//  MappedSnapshotSource — read-only replay of a .wsnap file
+// =====================================================================
+class MappedSnapshotSource final : public MemorySource {
+public:
+    MappedSnapshotSource() = default;
+    explicit MappedSnapshotSource(const std::string& file) { Open(file); }
+    ~MappedSnapshotSource() override;
+
+    MappedSnapshotSource(const MappedSnapshotSource&) = delete;
+    MappedSnapshotSource& operator=(const MappedSnapshotSource&) = delete;
+
+    // Map `file` and validate its header and tables.
+    bool Open(const std::string& file);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+
+    uint64_t DataBytes() const { return header.dataBytes; }
+
+    // Pointer into the mapping for [addr, addr + size) if it lies inside
+    // one region; no copy.
+    const uint8_t* Data(uintptr_t addr, size_t size) const;
+
+    // Module name of region `i` of Regions(), or "".
+    std::string RegionModule(size_t i) const;
+
+    size_t Read(uintptr_t addr, void* dst, size_t size) override;
+    std::vector<MemoryRegion> Regions() override;
+    std::vector<ModuleInfo>   Modules() override { return modules; }
+    bool Valid() const override { return IsOpen(); }
+
+private:
+    // Index of the region containing `addr`, or -1.
+    ptrdiff_t Find(uintptr_t addr) const;
+
+    const uint8_t*             base    = nullptr;    // the mapping
+    uint64_t                   mapSize = 0;
+    SnapshotHeader             header;
+    const SnapshotRegionEntry* regions = nullptr;    // inside the mapping
+    std::vector<ModuleInfo>    modules;
+
+#if defined(_WIN32)
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mapping    = nullptr;
+#endif
+};
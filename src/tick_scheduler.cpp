@@ -0,0 +1,200 @@
+#include "tick_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// How early the condition-variable wait hands over to the precise
+// sleep.  Windows waits are timer-tick granular (~15.6 ms).
+#if defined(_WIN32)
+static constexpr auto kPreciseSlack = std::chrono::milliseconds(16);
+#else
+static constexpr auto kPreciseSlack = std::chrono::milliseconds(2);
+#endif
+
+TickScheduler::TickScheduler()
+{
+#if defined(_WIN32)
+    timer = CreateWaitableTimerExW(nullptr, nullptr,
+                                   CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                   TIMER_ALL_ACCESS);
+    if (!timer)     // before Windows 10 1803: a plain timer still beats Sleep()
+        timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+#endif
+}
+
+TickScheduler::~TickScheduler()
+{
+#if defined(_WIN32)
+    if (timer) CloseHandle(timer);
+#endif
+}
+
+// =====================================================================
+//  Any thread
+// =====================================================================
+
+void TickScheduler::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        woken = true;
+    }
+    cv.notify_all();
+}
+
+void TickScheduler::NotifyFrame()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        ++frameSeq;
+    }
+    cv.notify_all();
+}
+
+TickScheduler::Stats TickScheduler::GetStats() const
+{
+    std::lock_guard<std::mutex> lk(mtx);
+    Stats st;
+    st.ticks    = ticks;
+    st.overruns = overruns;
+
+    size_t n = static_cast<size_t>(std::min<uint64_t>(recorded, kWindow));
+    if (n == 0) return st;
+
+    double sumPeriod = 0, sumBusy = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sumPeriod += periods[i];
+        sumBusy   += busyUs[i];
+    }
+    double mean = sumPeriod / n;
+    double var  = 0;
+    for (size_t i = 0; i < n; ++i)
+        var += (periods[i] - mean) * (periods[i] - mean);
+
+    st.periodMs = mean / 1000.0;
+    st.jitterMs = std::sqrt(var / n) / 1000.0;
+    st.rateHz   = mean > 0 ? 1e6 / mean : 0;
+    st.busy     = sumPeriod > 0 ? sumBusy / sumPeriod : 0;
+    return st;
+}
+
+// =====================================================================
+//  Worker thread
+// =====================================================================
+
+void TickScheduler::Reset()
+{
+    std::lock_guard<std::mutex> lk(mtx);
+    woken     = false;
+    seenFrame = frameSeq;
+    haveLast  = false;
+    recorded  = 0;
+    ticks     = 0;
+    overruns  = 0;
+}
+
+bool TickScheduler::WaitNextTick(ScheduleMode mode, double intervalMs, double cpuBudget)
+{
+    std::unique_lock<std::mutex> lk(mtx);
+    if (woken) {
+        woken = false;
+        return false;
+    }
+
+    if (mode == ScheduleMode::FrameAligned) {
+        cv.wait(lk, [&] { return woken || frameSeq != seenFrame; });
+        if (woken) {
+            woken = false;
+            return false;
+        }
+        seenFrame = frameSeq;
+        lastDue   = Clock::now();
+        return true;
+    }
+
+    // Due time from the previous tick; recomputed (not advanced) if a
+    // wait is interrupted, so Wake() never skips or shifts a deadline.
+    auto now = Clock::now();
+    auto due = now;
+    bool overrun = false;
+    if (haveLast) {
+        if (mode == ScheduleMode::FixedRate) {
+            auto period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(std::max(intervalMs, 0.0)));
+            due = lastDue + period;
+            if (now - due >= period) {      // a whole period behind: resync
+                due     = now;
+                overrun = true;
+            }
+        } else {
+            // Sleep so that busy / (busy + sleep) == budget
+            double b = std::clamp(cpuBudget, 0.01, 1.0);
+            due = lastEnd + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(lastBusy) * ((1.0 - b) / b));
+        }
+    }
+
+    if (!WaitUntil(lk, due)) return false;
+    lastDue = due;
+    overruns += overrun;
+    return true;
+}
+
+void TickScheduler::TickStarted()
+{
+    std::lock_guard<std::mutex> lk(mtx);
+    auto now = Clock::now();
+    if (haveLast) {
+        size_t i = static_cast<size_t>(recorded++ % kWindow);
+        periods[i] = std::chrono::duration<double, std::micro>(now - lastStart).count();
+        busyUs[i]  = std::chrono::duration<double, std::micro>(lastBusy).count();
+    }
+    lastStart = now;
+    ++ticks;
+}
+
+void TickScheduler::TickFinished()
+{
+    std::lock_guard<std::mutex> lk(mtx);
+    lastEnd  = Clock::now();
+    lastBusy = lastEnd - lastStart;
+    haveLast = true;
+}
+
+// =====================================================================
+//  Waiting
+// =====================================================================
+
+bool TickScheduler::WaitUntil(std::unique_lock<std::mutex>& lk, Clock::time_point t)
+{
+    if (cv.wait_until(lk, t - kPreciseSlack, [this] { return woken; })) {
+        woken = false;
+        return false;
+    }
+
+    // A Wake() during the last stretch stays pending for the next wait
+    lk.unlock();
+    SleepPrecise(t);
+    lk.lock();
+    return true;
+}
+
+void TickScheduler::SleepPrecise(Clock::time_point t)
+{
+    auto now = Clock::now();
+    if (t <= now) return;
+
+#if defined(_WIN32)
+    if (timer) {
+        LARGE_INTEGER due{};
+        due.QuadPart = -static_cast<LONGLONG>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t - now).count() / 100);
+        if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(timer, INFINITE);
+            return;
+        }
+    }
+#endif
+    std::this_thread::sleep_until(t);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+// ── Read scheduling modes ────────────────────────────────────────────
+enum class ScheduleMode : int {
+    FixedRate    = 0,   // one tick every interval, deadlines don't drift
+    MaxRate      = 1,   // back to back, sleeping enough to stay in a CPU budget
+    FrameAligned = 2,   // one tick per overlay frame (NotifyFrame())
+};
+
+// =====================================================================
+//  TickScheduler — deadline-based pacing for a worker loop
+// =====================================================================
+// The worker asks WaitNextTick() for the next due time and brackets its
+// work with TickStarted()/TickFinished().  Deadlines are absolute, so a
+// tick's own duration doesn't stretch the period, and a fixed-rate
+// schedule stays phase-locked instead of drifting.
+//
+// Waits are interruptible: Wake() (from any thread) makes the current
+// wait return early so the worker can re-check its state (stop, new
+// request, reading switched on/off).  Idle workers block in WaitIdle()
+// on the condition variable instead of polling.
+//
+// Timing: a condition-variable wait gets close to the deadline, the
+// last stretch is slept on a high-resolution timer (a high-resolution
+// waitable timer on Windows, where a plain wait is ~15 ms granular).
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TickScheduler();
+    ~TickScheduler();
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    // ── Any thread ───────────────────────────────────────────────────
+
+    // Make the worker's current (or next) wait return early.
+    void Wake();
+
+    // An overlay frame was presented; releases one FrameAligned tick.
+    void NotifyFrame();
+
+    struct Stats {
+        double   rateHz   = 0;      // achieved tick rate
+        double   periodMs = 0;      // mean start-to-start period
+        double   jitterMs = 0;      // standard deviation of the period
+        double   busy     = 0;      // fraction of the period spent ticking
+        uint64_t ticks    = 0;
+        uint64_t overruns = 0;      // FixedRate ticks a whole period late
+    };
+    // Over the last kWindow ticks.
+    Stats GetStats() const;
+
+    // ── Worker thread ────────────────────────────────────────────────
+
+    // Forget past ticks (deadlines and stats), e.g. when a worker starts.
+    void Reset();
+
+    // Block until `ready()` holds or Wake() is called.  Past deadlines
+    // are dropped if it had to wait, so the next tick isn't "late".
+    template <typename Ready>
+    void WaitIdle(Ready ready)
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        if (ready()) return;
+        cv.wait(lk, [&] { return woken || ready(); });
+        woken    = false;
+        haveLast = false;
+    }
+
+    // Block until the next tick is due.  `intervalMs` is the FixedRate
+    // period; `cpuBudget` (0..1] the MaxRate busy fraction.  Returns
+    // false if Wake() cut the wait short.
+    bool WaitNextTick(ScheduleMode mode, double intervalMs, double cpuBudget);
+
+    void TickStarted();
+    void TickFinished();
+
+    static constexpr size_t kWindow = 128;
+
+private:
+    // Interruptible wait until `t`; false if woken.
+    bool WaitUntil(std::unique_lock<std::mutex>& lk, Clock::time_point t);
+
+    // Uninterruptible high-resolution sleep until `t`.
+    void SleepPrecise(Clock::time_point t);
+
+    mutable std::mutex      mtx;
+    std::condition_variable cv;
+    bool                    woken    = false;
+    uint64_t                frameSeq = 0;      // bumped by NotifyFrame()
+    uint64_t                seenFrame = 0;     // last frame a tick was run for
+
+    // Last tick (worker-owned, read under mtx by GetStats())
+    bool              haveLast = false;
+    Clock::time_point lastDue;
+    Clock::time_point lastStart;
+    Clock::time_point lastEnd;
+    Clock::duration   lastBusy{};
+
+    // Ring of the last kWindow periods and busy times (microseconds)
+    double   periods[kWindow] = {};
+    double   busyUs[kWindow]  = {};
+    uint64_t recorded = 0;          // samples written to the ring
+    uint64_t ticks    = 0;
+    uint64_t overruns = 0;
+
+#if defined(_WIN32)
+    HANDLE timer = nullptr;
+#endif
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// ── Triple buffer ────────────────────────────────────────────────────
+// Hands the newest value from one writer thread to one reader thread
+// without locks, waiting or copies.  Three slots rotate between the
+// roles "back" (writer fills it), "middle" (last published) and
+// "front" (reader looks at it):
+//
+//   writer:  fill Back(), then Publish()  — back and middle swap
+//   reader:  Acquire(), then read Front() — front and middle swap if
+//            something new was published since the last Acquire()
+//
+// Each side only ever touches its own slot plus one atomic exchange,
+// so both are wait-free.  The reader may skip values (only the newest
+// is kept); it never sees a half-written one.  Front() stays valid and
+// unchanged until the reader's next Acquire().
+//
+// Slots are reused, never reallocated: a writer that refills Back() in
+// place allocates nothing once every slot has grown to size.
+template <typename T>
+class TripleBuffer {
+public:
+    // ── Writer side ──────────────────────────────────────────────────
+    T& Back() { return slots[back]; }
+
+    void Publish()
+    {
+        uint32_t prev = middle.exchange(back | kFresh, std::memory_order_acq_rel);
+        back = prev & kIndex;
+    }
+
+    // ── Reader side ──────────────────────────────────────────────────
+
+    // True if a value was published since the last Acquire().
+    bool Fresh() const { return middle.load(std::memory_order_acquire) & kFresh; }
+
+    // Take the newest published value, if any.  Returns true if Front()
+    // changed.
+    bool Acquire()
+    {
+        if (!Fresh()) return false;
+        uint32_t prev = middle.exchange(front, std::memory_order_acq_rel);
+        front = prev & kIndex;
+        return true;
+    }
+
+    const T& Front() const { return slots[front]; }
+
+private:
+    static constexpr uint32_t kIndex = 3;
+    static constexpr uint32_t kFresh = 4;
+
+    T                     slots[3];
+    uint32_t              back  = 0;        // writer-owned
+    uint32_t              front = 1;        // reader-owned
+    std::atomic<uint32_t> middle{ 2 };      // slot index | kFresh
+};
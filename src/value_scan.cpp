@@ -0,0 +1,561 @@
+#include "value_scan.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define WD42_SSE2 1
+#endif
+
+static constexpr size_t kPageSize  = 4096;
+static constexpr size_t kChunkSize = 1u << 20;   // first-scan work item
+static constexpr size_t kPageBatch = 256;        // next-scan work item
+
+using CandidatePage = ValueScanner::CandidatePage;
+
+// =====================================================================
+//  Value helpers
+// =====================================================================
+
+size_t ValueTypeSize(ValueType type)
+{
+    switch (type) {
+    case ValueType::Int32:  return 4;
+    case ValueType::Int64:  return 8;
+    case ValueType::Float:  return 4;
+    case ValueType::Double: return 8;
+    }
+    return 4;
+}
+
+const char* ValueTypeName(ValueType type)
+{
+    switch (type) {
+    case ValueType::Int32:  return "int32";
+    case ValueType::Int64:  return "int64";
+    case ValueType::Float:  return "float";
+    case ValueType::Double: return "double";
+    }
+    return "?";
+}
+
+// Integer part of `v`, or 0 where the cast would be undefined (NaN,
+// infinities, |v| >= 2^63): target memory is full of such bit patterns.
+static int64_t IntegerPart(double v)
+{
+    constexpr double kLimit = 9223372036854775808.0;   // 2^63
+    if (!(v >= -kLimit && v < kLimit)) return 0;
+    return static_cast<int64_t>(v);
+}
+
+// True if the operand is representable in `type`, so converting it
+// for the compare neither wraps nor is undefined.
+static bool OperandFits(ValueType type, const ScanValue& v)
+{
+    switch (type) {
+    case ValueType::Int32:
+        return v.i >= std::numeric_limits<int32_t>::min() &&
+               v.i <= std::numeric_limits<int32_t>::max();
+    case ValueType::Float:
+        return !std::isfinite(v.f) || std::fabs(v.f) <= std::numeric_limits<float>::max();
+    case ValueType::Int64:
+    case ValueType::Double:
+        return true;
+    }
+    return false;
+}
+
+bool ParseScanValue(ValueType type, const char* text, ScanValue& out)
+{
+    if (!text || !*text) return false;
+    char* end = nullptr;
+    ScanValue v;
+    bool integral = type == ValueType::Int32 || type == ValueType::Int64;
+
+    errno = 0;
+    if (integral) {
+        // Decimal, or hex with a 0x prefix; never octal
+        const char* digits = text + (*text == '-' || *text == '+');
+        int base = (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) ? 16 : 10;
+        v.i = std::strtoll(text, &end, base);
+        v.f = static_cast<double>(v.i);
+    } else {
+        v.f = std::strtod(text, &end);
+        v.i = IntegerPart(v.f);
+    }
+    if (end == text || *end != '\0') return false;
+
+    // Out of range: overflow, not the underflow strtod also flags
+    if (errno == ERANGE && (integral || std::isinf(v.f))) return false;
+    if (!OperandFits(type, v)) return false;
+
+    out = v;
+    return true;
+}
+
+// Callers check OperandFits() first.
+template <typename T>
+static T Operand(const ScanValue& v)
+{
+    if constexpr (std::is_integral_v<T>) return static_cast<T>(v.i);
+    else                                 return static_cast<T>(v.f);
+}
+
+template <typename T>
+static bool SameBits(T x, T y)
+{
+    return std::memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+// ── Scalar predicate ─────────────────────────────────────────────────
+template <typename T, ValueCompare C>
+static bool Test(T cur, T prev, T a, T b)
+{
+    if constexpr (C == ValueCompare::Exact)     return cur == a;
+    if constexpr (C == ValueCompare::Range)     return cur >= a && cur <= b;
+    if constexpr (C == ValueCompare::Unknown)   return true;
+    if constexpr (C == ValueCompare::Changed)   return !SameBits(cur, prev);
+    if constexpr (C == ValueCompare::Unchanged) return SameBits(cur, prev);
+    if constexpr (C == ValueCompare::Increased) return cur > prev;
+    if constexpr (C == ValueCompare::Decreased) return cur < prev;
+    return false;
+}
+
+// =====================================================================
+//  Full-page compare kernels
+// =====================================================================
+// Compare every slot of a 4 KB page (against a/b, or against the
+// previous page image for the delta compares) and write one bit per
+// slot.  Returns the number of set bits.
+
+template <typename T, ValueCompare C>
+static uint32_t FullPageScalar(const uint8_t* cur, const uint8_t* prev,
+                               T a, T b, uint64_t* bits)
+{
+    constexpr size_t slots = kPageSize / sizeof(T);
+    uint32_t n = 0;
+
+    for (size_t w = 0; w < slots / 64; ++w) {
+        uint64_t word = 0;
+        for (size_t k = 0; k < 64; ++k) {
+            size_t s = w * 64 + k;
+            T c, p{};
+            std::memcpy(&c, cur + s * sizeof(T), sizeof(T));
+            if (prev) std::memcpy(&p, prev + s * sizeof(T), sizeof(T));
+            if (Test<T, C>(c, p, a, b)) word |= uint64_t{ 1 } << k;
+        }
+        bits[w] = word;
+        n += static_cast<uint32_t>(std::popcount(word));
+    }
+    return n;
+}
+
+#if defined(WD42_SSE2)
+
+// Per-vector lane masks.  `p` is the previous image (delta compares),
+// `va`/`vb` the broadcast operands.
+template <ValueCompare C>
+static inline int LanesI32(__m128i c, __m128i p, __m128i va, __m128i vb)
+{
+    const __m128i ones = _mm_set1_epi32(-1);
+    __m128i m = ones;
+    if constexpr (C == ValueCompare::Exact)     m = _mm_cmpeq_epi32(c, va);
+    if constexpr (C == ValueCompare::Range)     m = _mm_xor_si128(ones, _mm_or_si128(
+                                                    _mm_cmplt_epi32(c, va), _mm_cmpgt_epi32(c, vb)));
+    if constexpr (C == ValueCompare::Changed)   m = _mm_xor_si128(ones, _mm_cmpeq_epi32(c, p));
+    if constexpr (C == ValueCompare::Unchanged) m = _mm_cmpeq_epi32(c, p);
+    if constexpr (C == ValueCompare::Increased) m = _mm_cmpgt_epi32(c, p);
+    if constexpr (C == ValueCompare::Decreased) m = _mm_cmplt_epi32(c, p);
+    return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
+
+template <ValueCompare C>
+static inline int LanesF32(__m128 c, __m128 p, __m128 va, __m128 vb)
+{
+    __m128 m = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    if constexpr (C == ValueCompare::Exact)     m = _mm_cmpeq_ps(c, va);
+    if constexpr (C == ValueCompare::Range)     m = _mm_and_ps(_mm_cmpge_ps(c, va), _mm_cmple_ps(c, vb));
+    if constexpr (C == ValueCompare::Changed)   m = _mm_castsi128_ps(_mm_xor_si128(_mm_set1_epi32(-1),
+                                                    _mm_cmpeq_epi32(_mm_castps_si128(c), _mm_castps_si128(p))));
+    if constexpr (C == ValueCompare::Unchanged) m = _mm_castsi128_ps(
+                                                    _mm_cmpeq_epi32(_mm_castps_si128(c), _mm_castps_si128(p)));
+    if constexpr (C == ValueCompare::Increased) m = _mm_cmpgt_ps(c, p);
+    if constexpr (C == ValueCompare::Decreased) m = _mm_cmplt_ps(c, p);
+    return _mm_movemask_ps(m);
+}
+
+// 64-bit "all bits equal": both 32-bit halves equal.
+static inline __m128d SameBits64(__m128d c, __m128d p)
+{
+    __m128i e = _mm_cmpeq_epi32(_mm_castpd_si128(c), _mm_castpd_si128(p));
+    __m128i s = _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_castsi128_pd(_mm_and_si128(e, s));
+}
+
+template <ValueCompare C>
+static inline int LanesF64(__m128d c, __m128d p, __m128d va, __m128d vb)
+{
+    __m128d m = _mm_castsi128_pd(_mm_set1_epi32(-1));
+    if constexpr (C == ValueCompare::Exact)     m = _mm_cmpeq_pd(c, va);
+    if constexpr (C == ValueCompare::Range)     m = _mm_and_pd(_mm_cmpge_pd(c, va), _mm_cmple_pd(c, vb));
+    if constexpr (C == ValueCompare::Changed)   m = _mm_xor_pd(_mm_castsi128_pd(_mm_set1_epi32(-1)),
+                                                               SameBits64(c, p));
+    if constexpr (C == ValueCompare::Unchanged) m = SameBits64(c, p);
+    if constexpr (C == ValueCompare::Increased) m = _mm_cmpgt_pd(c, p);
+    if constexpr (C == ValueCompare::Decreased) m = _mm_cmplt_pd(c, p);
+    return _mm_movemask_pd(m);
+}
+
+template <ValueCompare C>
+static uint32_t FullPageI32(const uint8_t* cur, const uint8_t* prev,
+                            int32_t a, int32_t b, uint64_t* bits)
+{
+    const __m128i va = _mm_set1_epi32(a), vb = _mm_set1_epi32(b);
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t n = 0;
+
+    for (size_t w = 0; w < 16; ++w) {
+        uint64_t word = 0;
+        for (size_t v = 0; v < 16; ++v) {
+            size_t off = (w * 64 + v * 4) * 4;
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + off));
+            __m128i p = prev ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + off)) : zero;
+            word |= static_cast<uint64_t>(LanesI32<C>(c, p, va, vb)) << (v * 4);
+        }
+        bits[w] = word;
+        n += static_cast<uint32_t>(std::popcount(word));
+    }
+    return n;
+}
+
+template <ValueCompare C>
+static uint32_t FullPageF32(const uint8_t* cur, const uint8_t* prev,
+                            float a, float b, uint64_t* bits)
+{
+    const __m128 va = _mm_set1_ps(a), vb = _mm_set1_ps(b);
+    const __m128 zero = _mm_setzero_ps();
+    uint32_t n = 0;
+
+    for (size_t w = 0; w < 16; ++w) {
+        uint64_t word = 0;
+        for (size_t v = 0; v < 16; ++v) {
+            size_t off = (w * 64 + v * 4) * 4;
+            __m128 c = _mm_loadu_ps(reinterpret_cast<const float*>(cur + off));
+            __m128 p = prev ? _mm_loadu_ps(reinterpret_cast<const float*>(prev + off)) : zero;
+            word |= static_cast<uint64_t>(LanesF32<C>(c, p, va, vb)) << (v * 4);
+        }
+        bits[w] = word;
+        n += static_cast<uint32_t>(std::popcount(word));
+    }
+    return n;
+}
+
+template <ValueCompare C>
+static uint32_t FullPageF64(const uint8_t* cur, const uint8_t* prev,
+                            double a, double b, uint64_t* bits)
+{
+    const __m128d va = _mm_set1_pd(a), vb = _mm_set1_pd(b);
+    const __m128d zero = _mm_setzero_pd();
+    uint32_t n = 0;
+
+    for (size_t w = 0; w < 8; ++w) {
+        uint64_t word = 0;
+        for (size_t v = 0; v < 32; ++v) {
+            size_t off = (w * 64 + v * 2) * 8;
+            __m128d c = _mm_loadu_pd(reinterpret_cast<const double*>(cur + off));
+            __m128d p = prev ? _mm_loadu_pd(reinterpret_cast<const double*>(prev + off)) : zero;
+            word |= static_cast<uint64_t>(LanesF64<C>(c, p, va, vb)) << (v * 2);
+        }
+        bits[w] = word;
+        n += static_cast<uint32_t>(std::popcount(word));
+    }
+    return n;
+}
+
+#endif // WD42_SSE2
+
+// SSE2 for int32/float/double; int64 compares (cmpgt_epi64) need
+// SSE4.2, so int64 stays on the scalar kernel.
+template <typename T, ValueCompare C>
+static uint32_t FullPage(const uint8_t* cur, const uint8_t* prev,
+                         T a, T b, uint64_t* bits)
+{
+#if defined(WD42_SSE2)
+    if constexpr (std::is_same_v<T, int32_t>) return FullPageI32<C>(cur, prev, a, b, bits);
+    if constexpr (std::is_same_v<T, float>)   return FullPageF32<C>(cur, prev, a, b, bits);
+    if constexpr (std::is_same_v<T, double>)  return FullPageF64<C>(cur, prev, a, b, bits);
+#endif
+    return FullPageScalar<T, C>(cur, prev, a, b, bits);
+}
+
+// =====================================================================
+//  Page refinement
+// =====================================================================
+
+// Pack the values of every set slot of `page` out of `data`.
+template <typename T>
+static void PackValues(CandidatePage& page, const uint8_t* data)
+{
+    constexpr size_t slots = kPageSize / sizeof(T);
+
+    if (page.count == slots) {
+        page.values.assign(data, data + kPageSize);
+        return;
+    }
+
+    page.values.resize(static_cast<size_t>(page.count) * sizeof(T));
+    uint8_t* out = page.values.data();
+    for (size_t w = 0; w < slots / 64; ++w) {
+        uint64_t word = page.bits[w];
+        while (word) {
+            size_t s = w * 64 + static_cast<size_t>(std::countr_zero(word));
+            std::memcpy(out, data + s * sizeof(T), sizeof(T));
+            out += sizeof(T);
+            word &= word - 1;
+        }
+    }
+}
+
+// First scan of one page.  Returns false if nothing matched.
+template <typename T, ValueCompare C>
+static bool FirstPage(CandidatePage& page, const uint8_t* data, T a, T b)
+{
+    constexpr size_t slots = kPageSize / sizeof(T);
+
+    if constexpr (C == ValueCompare::Unknown) {
+        for (size_t w = 0; w < slots / 64; ++w) page.bits[w] = ~uint64_t{ 0 };
+        page.count = static_cast<uint32_t>(slots);
+    } else {
+        page.count = FullPage<T, C>(data, nullptr, a, b, page.bits);
+    }
+
+    if (page.count == 0) return false;
+    PackValues<T>(page, data);
+    return true;
+}
+
+// Next scan of one page against its current bytes.  Returns false if
+// no candidate survived.
+template <typename T, ValueCompare C>
+static bool NextPage(CandidatePage& page, const uint8_t* data, T a, T b)
+{
+    constexpr size_t slots = kPageSize / sizeof(T);
+
+    if (page.count == slots) {
+        // Dense: the stored values are the whole previous page image
+        uint64_t bits[16] = {};
+        page.count = FullPage<T, C>(data, page.values.data(), a, b, bits);
+        std::memcpy(page.bits, bits, sizeof(bits));
+    } else {
+        // Sparse: walk set bits, previous values are packed in order
+        const uint8_t* prev = page.values.data();
+        uint32_t n = 0;
+        for (size_t w = 0; w < slots / 64; ++w) {
+            uint64_t word = page.bits[w], keep = 0;
+            while (word) {
+                unsigned k = static_cast<unsigned>(std::countr_zero(word));
+                T c, p;
+                std::memcpy(&c, data + (w * 64 + k) * sizeof(T), sizeof(T));
+                std::memcpy(&p, prev, sizeof(T));
+                prev += sizeof(T);
+                if (Test<T, C>(c, p, a, b)) keep |= uint64_t{ 1 } << k;
+                word &= word - 1;
+            }
+            page.bits[w] = keep;
+            n += static_cast<uint32_t>(std::popcount(keep));
+        }
+        page.count = n;
+    }
+
+    if (page.count == 0) return false;
+    PackValues<T>(page, data);
+    return true;
+}
+
+// ── Dispatch on (type, compare) once per scan ────────────────────────
+template <template <typename, ValueCompare> class Op>
+static bool Dispatch(ValueType type, ValueCompare cmp, const ScanValue& a,
+                     const ScanValue& b, CandidatePage& page, const uint8_t* data)
+{
+    auto byCmp = [&](auto tag) -> bool {
+        using T = decltype(tag);
+        T va = Operand<T>(a), vb = Operand<T>(b);
+        switch (cmp) {
+        case ValueCompare::Exact:     return Op<T, ValueCompare::Exact>::Run(page, data, va, vb);
+        case ValueCompare::Range:     return Op<T, ValueCompare::Range>::Run(page, data, va, vb);
+        case ValueCompare::Unknown:   return Op<T, ValueCompare::Unknown>::Run(page, data, va, vb);
+        case ValueCompare::Changed:   return Op<T, ValueCompare::Changed>::Run(page, data, va, vb);
+        case ValueCompare::Unchanged: return Op<T, ValueCompare::Unchanged>::Run(page, data, va, vb);
+        case ValueCompare::Increased: return Op<T, ValueCompare::Increased>::Run(page, data, va, vb);
+        case ValueCompare::Decreased: return Op<T, ValueCompare::Decreased>::Run(page, data, va, vb);
+        }
+        return false;
+    };
+
+    switch (type) {
+    case ValueType::Int32:  return byCmp(int32_t{});
+    case ValueType::Int64:  return byCmp(int64_t{});
+    case ValueType::Float:  return byCmp(float{});
+    case ValueType::Double: return byCmp(double{});
+    }
+    return false;
+}
+
+template <typename T, ValueCompare C>
+struct FirstOp { static bool Run(CandidatePage& p, const uint8_t* d, T a, T b) { return FirstPage<T, C>(p, d, a, b); } };
+
+template <typename T, ValueCompare C>
+struct NextOp  { static bool Run(CandidatePage& p, const uint8_t* d, T a, T b) { return NextPage<T, C>(p, d, a, b); } };
+
+// =====================================================================
+//  ValueScanner
+// =====================================================================
+
+void ValueScanner::Reset()
+{
+    pages.clear();
+    pages.shrink_to_fit();
+    count   = 0;
+    scanned = false;
+    lastMs  = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+size_t ValueScanner::FirstScan(MemorySource& mem, ValueType newType, ValueCompare cmp,
+                               const ScanValue& a, const ScanValue& b)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    Reset();
+    type = newType;
+
+    if (cmp != ValueCompare::Exact && cmp != ValueCompare::Range &&
+        cmp != ValueCompare::Unknown)
+        return 0;
+    if (!OperandFits(type, a) || !OperandFits(type, b))
+        return 0;
+
+    // Page-aligned work items of up to kChunkSize bytes
+    struct Item { uintptr_t base; size_t size; };
+    std::vector<Item> items;
+    for (const auto& r : mem.Regions()) {
+        for (size_t off = 0; off < r.size; off += kChunkSize)
+            items.push_back({ r.base + off, std::min(kChunkSize, r.size - off) });
+    }
+
+    std::vector<std::vector<CandidatePage>> found(items.size());
+    ParallelFor(items.size(), threads, [&](size_t i) {
+        thread_local std::vector<uint8_t> buf;
+        buf.resize(kChunkSize);
+
+        size_t got = mem.Read(items[i].base, buf.data(), items[i].size);
+        for (size_t off = 0; off + kPageSize <= got; off += kPageSize) {
+            CandidatePage page;
+            page.base = items[i].base + off;
+            if (Dispatch<FirstOp>(type, cmp, a, b, page, buf.data() + off))
+                found[i].push_back(std::move(page));
+        }
+    });
+
+    for (auto& f : found) {
+        for (auto& p : f) {
+            count += p.count;
+            pages.push_back(std::move(p));
+        }
+    }
+
+    scanned = true;
+    lastMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    return count;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+size_t ValueScanner::NextScan(MemorySource& mem, ValueCompare cmp,
+                              const ScanValue& a, const ScanValue& b)
+{
+    if (!scanned || cmp == ValueCompare::Unknown) return count;
+    if (!OperandFits(type, a) || !OperandFits(type, b)) return count;
+    auto t0 = std::chrono::steady_clock::now();
+
+    size_t batches = (pages.size() + kPageBatch - 1) / kPageBatch;
+    std::vector<uint8_t> keep(pages.size(), 0);
+
+    ParallelFor(batches, threads, [&](size_t bi) {
+        thread_local std::vector<uint8_t> buf;
+        buf.resize(kPageBatch * kPageSize);
+
+        size_t first = bi * kPageBatch;
+        size_t last  = std::min(first + kPageBatch, pages.size());
+
+        // Read runs of adjacent candidate pages in one call each
+        for (size_t i = first; i < last; ) {
+            size_t j = i + 1;
+            while (j < last && pages[j].base == pages[j - 1].base + kPageSize) ++j;
+
+            size_t got = mem.Read(pages[i].base, buf.data(), (j - i) * kPageSize);
+            for (size_t k = i; k < j; ++k) {
+                size_t off = (k - i) * kPageSize;
+                if (off + kPageSize > got) break;     // unmapped since: drop
+                keep[k] = Dispatch<NextOp>(type, cmp, a, b, pages[k], buf.data() + off);
+            }
+            i = j;
+        }
+    });
+
+    size_t out = 0;
+    count = 0;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if (!keep[i]) continue;
+        count += pages[i].count;
+        if (out != i) pages[out] = std::move(pages[i]);
+        ++out;
+    }
+    pages.resize(out);
+
+    lastMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    return count;
+}
+
+// ─────────────────────────────────────────────────────────────────────
+void ValueScanner::Peek(size_t max, std::vector<ValueHit>& out) const
+{
+    out.clear();
+    size_t sz = ValueTypeSize(type);
+    size_t slots = kPageSize / sz;
+
+    for (const auto& page : pages) {
+        const uint8_t* v = page.values.data();
+        bool dense = (page.count == slots);
+
+        for (size_t w = 0; w < slots / 64; ++w) {
+            uint64_t word = page.bits[w];
+            while (word) {
+                if (out.size() >= max) return;
+                size_t s = w * 64 + static_cast<size_t>(std::countr_zero(word));
+                const uint8_t* src = dense ? page.values.data() + s * sz : v;
+                if (!dense) v += sz;
+
+                ValueHit h;
+                h.address = page.base + s * sz;
+                switch (type) {
+                case ValueType::Int32:  { int32_t x; std::memcpy(&x, src, 4); h.value.i = x; h.value.f = x; break; }
+                case ValueType::Int64:  { int64_t x; std::memcpy(&x, src, 8); h.value.i = x; h.value.f = static_cast<double>(x); break; }
+                case ValueType::Float:  { float   x; std::memcpy(&x, src, 4); h.value.f = x; h.value.i = IntegerPart(x); break; }
+                case ValueType::Double: { double  x; std::memcpy(&x, src, 8); h.value.f = x; h.value.i = IntegerPart(x); break; }
+                }
+                out.push_back(h);
+                word &= word - 1;
+            }
+        }
+    }
+}
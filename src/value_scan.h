@@ -0,0 +1,97 @@
+#pragma once
+
+#include "memory_source.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ── Value scanner ────────────────────────────────────────────────────
+// Classic first-scan / next-scan narrowing over the target's readable
+// memory for int32, int64, float and double (naturally aligned slots).
+//
+// Candidates are kept per 4 KB page as a bitmap of aligned slots plus
+// the last-seen value of every set slot, packed in slot order.  Pages
+// where every slot is still a candidate (unknown initial value) keep a
+// plain page image and are refined with SIMD compare kernels; sparse
+// pages walk their set bits.  Both scans are spread over a worker pool.
+//
+// Float/double "changed"/"unchanged" compare bit patterns, so NaN stays
+// "unchanged" and -0.0 vs +0.0 counts as a change.
+
+enum class ValueType {
+    Int32,
+    Int64,
+    Float,
+    Double,
+};
+
+enum class ValueCompare {
+    Exact,       // == a
+    Range,       // a <= v <= b
+    Unknown,     // first scan only: every slot is a candidate
+    Changed,     // next scan only: != last-seen value
+    Unchanged,
+    Increased,
+    Decreased,
+};
+
+// A scan operand.  Integer types use `i`, float types use `f`.
+struct ScanValue {
+    int64_t i = 0;
+    double  f = 0;
+};
+
+// Parse user text into a ScanValue for `type` (decimal, or 0x.. hex for
+// integers).  Returns false if the text isn't a number or is outside
+// the range of `type`.
+bool ParseScanValue(ValueType type, const char* text, ScanValue& out);
+
+size_t ValueTypeSize(ValueType type);
+const char* ValueTypeName(ValueType type);
+
+struct ValueHit {
+    uintptr_t address = 0;
+    ScanValue value;            // value seen by the last scan
+};
+
+class ValueScanner {
+public:
+    // Start over: scan all readable memory (Exact, Range or Unknown).
+    // Returns the number of candidates.  Operands outside the range of
+    // `type` match nothing (and NextScan() leaves the candidates as
+    // they are).
+    size_t FirstScan(MemorySource& mem, ValueType type, ValueCompare cmp,
+                     const ScanValue& a, const ScanValue& b = {});
+
+    // Refine the current candidates (any compare except Unknown).
+    size_t NextScan(MemorySource& mem, ValueCompare cmp,
+                    const ScanValue& a = {}, const ScanValue& b = {});
+
+    void Reset();
+
+    bool      HasScan() const { return scanned; }
+    size_t    Count()   const { return count; }
+    ValueType Type()    const { return type; }
+    double    LastMs()  const { return lastMs; }
+
+    // Up to `max` candidates in address order, with their last-seen values.
+    void Peek(size_t max, std::vector<ValueHit>& out) const;
+
+    // Worker threads for both scans (0 = one per hardware thread).
+    unsigned threads = 0;
+
+    struct CandidatePage {
+        uintptr_t            base  = 0;
+        uint32_t             count = 0;      // set slots
+        uint64_t             bits[16] = {};  // one bit per aligned slot
+        std::vector<uint8_t> values;         // last-seen values of set slots
+    };
+
+private:
+    std::vector<CandidatePage> pages;     // sorted by base
+    ValueType type    = ValueType::Int32;
+    size_t    count   = 0;
+    bool      scanned = false;
+    double    lastMs  = 0;
+};